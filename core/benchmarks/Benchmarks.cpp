@@ -0,0 +1,596 @@
+#include "StdInclude.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include "Utilities/ArcLengthTable.hpp"
+#include "Utilities/DemoIndex.hpp"
+#include "Utilities/FrameClock.hpp"
+#include "Utilities/KeyframeFilters.hpp"
+#include "Utilities/KeyframeReduction.hpp"
+#include "Utilities/KeyframeUtils.hpp"
+#include "Utilities/MeshUtils.hpp"
+#include "Utilities/NaturalSort.hpp"
+#include "Utilities/PatternScanner.hpp"
+#include "Utilities/RotationSpline.hpp"
+#include "Utilities/SegmentTable.hpp"
+#include "Utilities/TimeRemapTable.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+// Benchmarks for the game-independent kernels of core. Results are written as JSON, and can be compared against the
+// results of an earlier run:
+//
+//   iwxmvm-benchmarks --output baseline.json
+//   iwxmvm-benchmarks --baseline baseline.json [--tolerance 0.1] [--filter SegmentTable]
+//
+// The comparison exits with 1 if any benchmark got slower than the baseline by more than the tolerance.
+
+namespace IWXMVM::Benchmarks
+{
+    using namespace std::chrono_literals;
+
+    constexpr auto MIN_REPETITION_DURATION = 100ms;
+    constexpr std::size_t REPETITION_COUNT = 5;
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        double nanosecondsPerIteration;
+    };
+
+    // keeps the compiler from optimizing away results that are otherwise unused
+    volatile float sink;
+
+    void Consume(float value)
+    {
+        sink = value;
+    }
+
+    class Runner
+    {
+       public:
+        explicit Runner(std::string filter) : filter(std::move(filter))
+        {
+        }
+
+        // Runs the function until a repetition took long enough and reports the fastest of several repetitions
+        template <typename Function>
+        void Run(const std::string& name, Function&& function)
+        {
+            if (!filter.empty() && name.find(filter) == std::string::npos)
+                return;
+
+            uint64_t iterations = 1;
+            auto best = std::numeric_limits<double>::max();
+            for (std::size_t repetition = 0; repetition < REPETITION_COUNT;)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                for (uint64_t i = 0; i < iterations; i++)
+                    function();
+                const auto duration = std::chrono::steady_clock::now() - start;
+
+                if (duration < MIN_REPETITION_DURATION)
+                {
+                    iterations *= 2;
+                    continue;
+                }
+
+                const auto nanoseconds = std::chrono::duration<double, std::nano>(duration).count();
+                best = std::min(best, nanoseconds / static_cast<double>(iterations));
+                repetition++;
+            }
+
+            std::fprintf(stderr, "%-48s %14.1f ns\n", name.c_str(), best);
+            results.push_back({name, iterations, best});
+        }
+
+        const std::vector<Result>& GetResults() const
+        {
+            return results;
+        }
+
+       private:
+        std::string filter;
+        std::vector<Result> results;
+    };
+
+    const Types::KeyframeableProperty cameraProperty(Types::KeyframeablePropertyType::CampathCamera, "Camera",
+                                                     Types::KeyframeValueType::CameraData, -10000.0f, 10000.0f);
+    const Types::KeyframeableProperty speedProperty(Types::KeyframeablePropertyType::PlaybackSpeed, "Speed",
+                                                    Types::KeyframeValueType::FloatingPoint, 0.0f, 4.0f);
+
+    // A smooth camera flight with a node every 50 ticks, whose yaw keeps turning past +-180 degrees
+    std::vector<Types::Keyframe> MakeCameraTrack(std::size_t count)
+    {
+        std::vector<Types::Keyframe> keyframes;
+        keyframes.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const auto t = static_cast<float>(i);
+            Types::CameraData node;
+            node.position = glm::vec3(std::cos(t * 0.1f) * 1000.0f, std::sin(t * 0.13f) * 1000.0f, t * 4.0f);
+            node.rotation = glm::vec3(std::sin(t * 0.2f) * 30.0f, std::fmod(t * 25.0f, 360.0f) - 180.0f, 0.0f);
+            node.fov = 90.0f + std::sin(t * 0.05f) * 10.0f;
+            keyframes.emplace_back(cameraProperty, static_cast<uint32_t>(i * 50), node);
+        }
+        return keyframes;
+    }
+
+    std::vector<Types::Keyframe> MakeSpeedTrack(std::size_t count)
+    {
+        std::vector<Types::Keyframe> keyframes;
+        keyframes.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const auto speed = 1.0f + std::sin(static_cast<float>(i) * 0.3f) * 0.9f;
+            keyframes.emplace_back(speedProperty, static_cast<uint32_t>(i * 200), speed);
+        }
+        return keyframes;
+    }
+
+    // ticks spread over the whole track in random order, so segment lookups don't always hit the same cache lines
+    std::vector<float> MakeEvaluationTicks(const std::vector<Types::Keyframe>& keyframes, std::size_t count)
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> distribution(static_cast<float>(keyframes.front().tick),
+                                                           static_cast<float>(keyframes.back().tick));
+        std::vector<float> ticks(count);
+        for (auto& tick : ticks)
+            tick = distribution(random);
+        return ticks;
+    }
+
+    void BenchmarkSegmentTable(Runner& runner)
+    {
+        for (const std::size_t count : {16, 256, 4096})
+        {
+            const auto keyframes = MakeCameraTrack(count);
+
+            MathUtils::SegmentTable table;
+            runner.Run("SegmentTable/Compile/" + std::to_string(count), [&] {
+                table.Compile(cameraProperty, keyframes);
+                Consume(table.Evaluate(0.0f).cameraData.fov);
+            });
+
+            table.Compile(cameraProperty, keyframes);
+            const auto ticks = MakeEvaluationTicks(keyframes, 1024);
+            std::size_t next = 0;
+            runner.Run("SegmentTable/Evaluate/" + std::to_string(count), [&] {
+                Consume(table.Evaluate(ticks[next++ % ticks.size()]).cameraData.fov);
+            });
+            runner.Run("SegmentTable/EvaluateVector3/" + std::to_string(count), [&] {
+                Consume(table.EvaluateVector3(ticks[next++ % ticks.size()]).x);
+            });
+        }
+    }
+
+    void BenchmarkRotationSpline(Runner& runner)
+    {
+        for (const std::size_t count : {16, 256, 4096})
+        {
+            const auto keyframes = MakeCameraTrack(count);
+
+            MathUtils::RotationSpline spline;
+            runner.Run("RotationSpline/Build/" + std::to_string(count), [&] {
+                spline.Build(keyframes);
+                Consume(spline.Evaluate(0.0f).x);
+            });
+
+            spline.Build(keyframes);
+            const auto ticks = MakeEvaluationTicks(keyframes, 1024);
+            std::size_t next = 0;
+            runner.Run("RotationSpline/Evaluate/" + std::to_string(count),
+                       [&] { Consume(spline.Evaluate(ticks[next++ % ticks.size()]).y); });
+            runner.Run("RotationSpline/EvaluateLinear/" + std::to_string(count),
+                       [&] { Consume(spline.EvaluateLinear(ticks[next++ % ticks.size()]).y); });
+        }
+    }
+
+    void BenchmarkArcLengthTable(Runner& runner)
+    {
+        const auto keyframes = MakeCameraTrack(256);
+        MathUtils::SegmentTable segmentTable;
+        segmentTable.Compile(cameraProperty, keyframes);
+        const auto velocity = [&](float tick) { return segmentTable.EvaluateVector3Derivative(tick); };
+
+        MathUtils::ArcLengthTable table;
+        runner.Run("ArcLengthTable/Rebuild/256", [&] {
+            table.Update(keyframes, velocity, true);
+            Consume(table.GetTotalLength());
+        });
+
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> distribution(0.0f, table.GetTotalLength());
+        runner.Run("ArcLengthTable/GetTickAtDistance/256",
+                   [&] { Consume(table.GetTickAtDistance(distribution(random))); });
+    }
+
+    void BenchmarkTimeRemapTable(Runner& runner)
+    {
+        const auto keyframes = MakeSpeedTrack(256);
+        MathUtils::SegmentTable segmentTable;
+        segmentTable.Compile(speedProperty, keyframes);
+        const auto speed = [&](float tick) { return segmentTable.Evaluate(tick).floatingPoint; };
+
+        runner.Run("TimeRemapTable/Build/256", [&] {
+            MathUtils::TimeRemapTable table;
+            table.Update(keyframes, speed);
+            Consume(static_cast<float>(table.GetOutputTime(keyframes.back().tick)));
+        });
+
+        MathUtils::TimeRemapTable table;
+        table.Update(keyframes, speed);
+        const auto totalTime = table.GetOutputTime(keyframes.back().tick);
+        std::mt19937 random(1);
+        std::uniform_real_distribution<double> distribution(0.0, totalTime);
+        runner.Run("TimeRemapTable/GetTickAtOutputTime/256",
+                   [&] { Consume(static_cast<float>(table.GetTickAtOutputTime(distribution(random)))); });
+    }
+
+    void BenchmarkKeyframeFilters(Runner& runner)
+    {
+        // the filters are meant for recorded campaths, which have a node every tick
+        const auto keyframes = MakeCameraTrack(100000);
+        const std::array<std::pair<const char*, MathUtils::SmoothingFilter>, 3> filters = {{
+            {"Gaussian", MathUtils::SmoothingFilter::Gaussian},
+            {"SavitzkyGolay", MathUtils::SmoothingFilter::SavitzkyGolay},
+            {"OneEuro", MathUtils::SmoothingFilter::OneEuro},
+        }};
+
+        for (const auto& [name, filter] : filters)
+        {
+            MathUtils::SmoothingSettings settings;
+            settings.filter = filter;
+            runner.Run(std::string("KeyframeFilters/") + name + "/100000", [&] {
+                Consume(MathUtils::SmoothKeyframes(cameraProperty, keyframes, settings).back().cameraData.fov);
+            });
+        }
+    }
+
+    void BenchmarkKeyframeReduction(Runner& runner)
+    {
+        // a recorded campath: a node every tick along a slowly turning flight, which mostly reduces away
+        std::vector<Types::Keyframe> keyframes;
+        for (std::size_t i = 0; i < 20000; i++)
+        {
+            const auto t = static_cast<float>(i) * 0.01f;
+            Types::CameraData node;
+            node.position = glm::vec3(std::cos(t * 0.7f) * 2000.0f, std::sin(t) * 1500.0f, std::sin(t * 0.3f) * 200.0f);
+            node.rotation = glm::vec3(std::sin(t * 0.9f) * 20.0f, std::fmod(t * 40.0f, 360.0f) - 180.0f, 0.0f);
+            node.fov = 80.0f + std::sin(t * 0.5f) * 5.0f;
+            auto& keyframe = keyframes.emplace_back(cameraProperty, static_cast<uint32_t>(i), node);
+            keyframe.interpolation.mode = Types::KeyframeInterpolationMode::Cubic;
+        }
+
+        std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT> tolerances{};
+        for (int32_t j = 0; j < cameraProperty.GetValueCount(); j++)
+            tolerances[j] = MathUtils::GetDefaultReductionTolerance(cameraProperty, static_cast<uint32_t>(j));
+
+        runner.Run("KeyframeReduction/ReduceKeyframes/20000", [&] {
+            const auto result = MathUtils::ReduceKeyframes(cameraProperty, keyframes, tolerances);
+            Consume(static_cast<float>(result.removedKeyframes.size()));
+        });
+    }
+
+    void BenchmarkKeyframeUtils(Runner& runner)
+    {
+        // what KeyframeManager does when half of a recorded campath is deleted and the deletion is undone
+        auto track = MakeCameraTrack(100000);
+        std::vector<Types::Keyframe> selection;
+        for (std::size_t i = 0; i < track.size(); i += 2)
+            selection.push_back(track[i]);
+
+        KeyframeUtils::SlotIndex index;
+        runner.Run("KeyframeUtils/RemoveAndUndo/100000", [&] {
+            KeyframeUtils::EraseKeyframes(track, selection);
+            KeyframeUtils::BuildSlotIndex(track, index);
+            KeyframeUtils::AppendKeyframes(track, selection, index);
+            KeyframeUtils::SortByTick(track);
+            KeyframeUtils::BuildSlotIndex(track, index);
+            Consume(static_cast<float>(index.size()));
+        });
+    }
+
+    void BenchmarkPatternScanner(Runner& runner)
+    {
+        // machine code is mostly zeroes, register encodings and int3 padding
+        std::mt19937 random(1);
+        std::discrete_distribution<int> byteClass({30, 5, 5, 3, 57});
+        std::uniform_int_distribution<int> anyByte(0, 255);
+        std::vector<std::uint8_t> image(16 * 1024 * 1024);
+        for (auto& byte : image)
+        {
+            constexpr std::array<std::uint8_t, 4> COMMON_BYTES = {0x00, 0xFF, 0x8B, 0xCC};
+            const auto c = byteClass(random);
+            byte = c < 4 ? COMMON_BYTES[c] : static_cast<std::uint8_t>(anyByte(random));
+        }
+
+        // signatures like the game's: 12 to 28 bytes taken from the image, with masked 4 byte addresses in them
+        std::vector<std::vector<std::uint16_t>> signatures;
+        std::uniform_int_distribution<std::size_t> position(0, image.size() - 32);
+        for (std::size_t i = 0; i < 64; i++)
+        {
+            const auto start = position(random);
+            const auto length = 12 + i % 17;
+            std::vector<std::uint16_t> bytes(image.begin() + start, image.begin() + start + length);
+            for (std::size_t j = 3; j + 5 < length; j += 9)
+                std::fill_n(bytes.begin() + j, 4, Signatures::maskValue);
+            signatures.push_back(std::move(bytes));
+        }
+
+        std::vector<Signatures::ScanPattern> patterns;
+        for (const auto& bytes : signatures)
+            patterns.push_back({bytes, 0});
+
+        runner.Run("PatternScanner/ScanForPatterns/16MB/64", [&] {
+            const auto matches = Signatures::ScanForPatterns(image, patterns);
+            Consume(static_cast<float>(matches.front() - image.data()));
+        });
+    }
+
+    void BenchmarkFrameClock(Runner& runner)
+    {
+        MathUtils::FrameClock clock(24000, 1001);
+        runner.Run("FrameClock/Advance", [&] { Consume(static_cast<float>(clock.Advance())); });
+    }
+
+    // Half an hour of a demo: a snapshot every 50 ms, each a network packet followed by a client archive
+    void WriteDemo(const std::filesystem::path& path, std::size_t snapshotCount)
+    {
+        std::mt19937 random(1);
+        std::uniform_int_distribution<int32_t> packetSize(100, 1400);
+
+        std::vector<char> demo;
+        auto Append = [&](const auto& value) {
+            const auto* bytes = reinterpret_cast<const char*>(&value);
+            demo.insert(demo.end(), bytes, bytes + sizeof(value));
+        };
+
+        for (std::size_t i = 0; i < snapshotCount; i++)
+        {
+            const auto size = packetSize(random);
+            Append(static_cast<uint8_t>(0));
+            Append(static_cast<int32_t>(i));
+            Append(size);
+            Append(static_cast<int32_t>(0));
+            demo.resize(demo.size() + size - 4);
+
+            DemoIndex::ClientArchive archive{};
+            archive.archiveIndex = static_cast<int>(i % 256);
+            archive.serverTime = 10000 + static_cast<int>(i) * 50;
+            Append(static_cast<uint8_t>(1));
+            Append(archive);
+        }
+
+        std::ofstream(path, std::ios::binary).write(demo.data(), static_cast<std::streamsize>(demo.size()));
+    }
+
+    void BenchmarkDemoIndex(Runner& runner)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "iwxmvm-benchmark.dm_1";
+        WriteDemo(path, 36000);
+
+        runner.Run("DemoIndex/Build/36000", [&] {
+            std::ifstream file(path, std::ios::binary);
+            const auto index = DemoIndex::Build(file);
+            Consume(static_cast<float>(index.archives.size()));
+        });
+
+        std::filesystem::remove(path);
+    }
+
+    // File names like the ones demos are saved with, numbered and in random order
+    std::vector<std::filesystem::path> MakeDemoPaths(std::size_t count)
+    {
+        constexpr std::array<const char*, 6> NAMES = {"match", "Match", "scrim_", "pub", "frag movie", "clip"};
+
+        std::mt19937 random(1);
+        std::uniform_int_distribution<std::size_t> name(0, NAMES.size() - 1);
+        std::uniform_int_distribution<int> number(0, 99999);
+
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const auto fileName = std::string(NAMES[name(random)]) + std::to_string(number(random)) + "_" +
+                                  std::to_string(i % 7) + "_round" + std::to_string(number(random) % 30) + ".dm_1";
+            paths.push_back(std::filesystem::path("demos") / fileName);
+        }
+        return paths;
+    }
+
+    void BenchmarkNaturalSort(Runner& runner)
+    {
+        const auto paths = MakeDemoPaths(100000);
+
+        std::vector<std::filesystem::path> sortedPaths;
+        runner.Run("NaturalSort/SortDemoPaths/100000", [&] {
+            sortedPaths = paths;
+            NaturalSort::SortDemoPaths(sortedPaths, std::string_view(".dm_1").length());
+            Consume(static_cast<float>(sortedPaths.front().native().size()));
+        });
+
+        using StringView = std::basic_string_view<std::filesystem::path::value_type>;
+        std::size_t next = 0;
+        runner.Run("NaturalSort/CompareNaturally", [&] {
+            const auto& lhs = paths[next++ % paths.size()].native();
+            const auto& rhs = paths[next % paths.size()].native();
+            Consume(NaturalSort::CompareNaturally<false>(StringView(lhs), StringView(rhs)) ? 1.0f : 0.0f);
+        });
+    }
+
+    // A sphere with a vertex color per ring, as an OBJ file whose faces share their vertices
+    std::string MakeSphereObj(int32_t segments, int32_t rings)
+    {
+        std::ostringstream obj;
+        for (int32_t ring = 0; ring <= rings; ring++)
+        {
+            const auto theta = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(rings);
+            for (int32_t segment = 0; segment < segments; segment++)
+            {
+                const auto phi = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+                const glm::vec3 normal(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                                       std::cos(theta));
+                const auto shade = static_cast<float>(ring) / static_cast<float>(rings);
+                obj << "v " << normal.x * 10.0f << ' ' << normal.y * 10.0f << ' ' << normal.z * 10.0f << ' ' << shade
+                    << ' ' << shade << ' ' << 1.0f - shade << '\n';
+                obj << "vn " << normal.x << ' ' << normal.y << ' ' << normal.z << '\n';
+            }
+        }
+
+        for (int32_t ring = 0; ring < rings; ring++)
+        {
+            for (int32_t segment = 0; segment < segments; segment++)
+            {
+                const auto a = ring * segments + segment + 1;
+                const auto b = ring * segments + (segment + 1) % segments + 1;
+                const auto c = a + segments;
+                const auto d = b + segments;
+                obj << "f " << a << "//" << a << ' ' << c << "//" << c << ' ' << b << "//" << b << '\n';
+                obj << "f " << b << "//" << b << ' ' << c << "//" << c << ' ' << d << "//" << d << '\n';
+            }
+        }
+        return obj.str();
+    }
+
+    void BenchmarkMeshUtils(Runner& runner)
+    {
+        // a gizmo's size, and a large mesh
+        for (const auto& [segments, rings] : {std::pair{16, 8}, std::pair{128, 64}})
+        {
+            const auto obj = MakeSphereObj(segments, rings);
+            const auto triangleCount = std::to_string(2 * segments * rings);
+
+            std::vector<Types::Vertex> vertices;
+            std::vector<Types::Index> indices;
+            std::string warning;
+            std::string error;
+            runner.Run("MeshUtils/LoadObj/" + triangleCount, [&] {
+                vertices.clear();
+                indices.clear();
+                MeshUtils::LoadObj(obj, vertices, indices, warning, error);
+                Consume(static_cast<float>(vertices.size()));
+            });
+
+            // the mouse is usually next to a gizmo and not on it, which has to test every triangle
+            const auto model = glm::translate(glm::mat4(1.0f), glm::vec3(100.0f, 50.0f, 20.0f));
+            const glm::vec3 origin(0.0f);
+            const glm::vec3 missingDirection(0.0f, 1.0f, 0.0f);
+            runner.Run("MeshUtils/IntersectsRay/Miss/" + triangleCount, [&] {
+                Consume(MeshUtils::IntersectsRay(vertices, indices, model, origin, missingDirection) ? 1.0f : 0.0f);
+            });
+        }
+    }
+
+    nlohmann::ordered_json ToJson(const std::vector<Result>& results)
+    {
+        auto benchmarks = nlohmann::ordered_json::array();
+        for (const auto& result : results)
+        {
+            benchmarks.push_back({
+                {"name", result.name},
+                {"iterations", result.iterations},
+                {"ns_per_iteration", result.nanosecondsPerIteration},
+            });
+        }
+        return {{"benchmarks", benchmarks}};
+    }
+
+    // Returns the number of benchmarks that got slower than the baseline by more than the tolerance
+    std::size_t CompareToBaseline(const std::vector<Result>& results, const nlohmann::json& baseline, double tolerance)
+    {
+        std::map<std::string, double> baselineTimes;
+        for (const auto& benchmark : baseline.at("benchmarks"))
+            baselineTimes[benchmark.at("name").get<std::string>()] = benchmark.at("ns_per_iteration").get<double>();
+
+        std::size_t regressionCount = 0;
+        std::fprintf(stderr, "\nCompared to the baseline:\n");
+        for (const auto& result : results)
+        {
+            const auto it = baselineTimes.find(result.name);
+            if (it == baselineTimes.end())
+            {
+                std::fprintf(stderr, "%-48s %10s\n", result.name.c_str(), "new");
+                continue;
+            }
+
+            const auto change = result.nanosecondsPerIteration / it->second - 1.0;
+            const bool regressed = change > tolerance;
+            regressionCount += regressed ? 1 : 0;
+            std::fprintf(stderr, "%-48s %+9.1f%%%s\n", result.name.c_str(), change * 100.0,
+                         regressed ? "  REGRESSION" : "");
+        }
+        return regressionCount;
+    }
+}  // namespace IWXMVM::Benchmarks
+
+int main(int argc, char** argv)
+{
+    using namespace IWXMVM::Benchmarks;
+
+    std::string filter;
+    std::optional<std::filesystem::path> outputPath;
+    std::optional<std::filesystem::path> baselinePath;
+    double tolerance = 0.1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--filter" && hasValue)
+            filter = argv[++i];
+        else if (argument == "--output" && hasValue)
+            outputPath = argv[++i];
+        else if (argument == "--baseline" && hasValue)
+            baselinePath = argv[++i];
+        else if (argument == "--tolerance" && hasValue)
+            tolerance = std::stod(argv[++i]);
+        else
+        {
+            std::fprintf(stderr, "Usage: iwxmvm-benchmarks [--filter name] [--output file] [--baseline file] "
+                                 "[--tolerance fraction]\n");
+            return 2;
+        }
+    }
+
+    nlohmann::json baseline;
+    if (baselinePath.has_value())
+    {
+        std::ifstream file(baselinePath.value());
+        baseline = nlohmann::json::parse(file, nullptr, false);
+        if (!file.is_open() || baseline.is_discarded() || !baseline.contains("benchmarks"))
+        {
+            std::fprintf(stderr, "Failed to read the baseline %s\n", baselinePath->string().c_str());
+            return 2;
+        }
+    }
+
+    Runner runner(filter);
+    BenchmarkSegmentTable(runner);
+    BenchmarkRotationSpline(runner);
+    BenchmarkArcLengthTable(runner);
+    BenchmarkTimeRemapTable(runner);
+    BenchmarkKeyframeFilters(runner);
+    BenchmarkKeyframeReduction(runner);
+    BenchmarkKeyframeUtils(runner);
+    BenchmarkPatternScanner(runner);
+    BenchmarkFrameClock(runner);
+    BenchmarkDemoIndex(runner);
+    BenchmarkNaturalSort(runner);
+    BenchmarkMeshUtils(runner);
+
+    const auto json = ToJson(runner.GetResults()).dump(4);
+    if (outputPath.has_value())
+        std::ofstream(outputPath.value()) << json << '\n';
+    else
+        std::cout << json << '\n';
+
+    if (baselinePath.has_value() && CompareToBaseline(runner.GetResults(), baseline, tolerance) > 0)
+        return 1;
+
+    return 0;
+}
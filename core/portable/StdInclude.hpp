@@ -0,0 +1,56 @@
+#pragma once
+
+// Stands in for src/StdInclude.hpp in the portable CMake build (see CMakeLists.txt), which only compiles sources that
+// don't need Windows, D3D9, ImGui or the logger. Zones of the profiler are compiled out (IWXMVM_DISABLE_PROFILER).
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cwctype>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include <variant>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <execution>
+
+#include <emmintrin.h>
+
+// Types/Vertex.hpp stores colors the way D3D9 does, as in d3d9types.h
+using D3DCOLOR = uint32_t;
+#define D3DCOLOR_ARGB(a, r, g, b) \
+    ((D3DCOLOR)((((a) & 0xff) << 24) | (((r) & 0xff) << 16) | (((g) & 0xff) << 8) | ((b) & 0xff)))
+#define D3DCOLOR_COLORVALUE(r, g, b, a)                                                                          \
+    D3DCOLOR_ARGB((uint32_t)((a) * 255.f), (uint32_t)((r) * 255.f), (uint32_t)((g) * 255.f), (uint32_t)((b) * 255.f))
+
+#include "glm/glm.hpp"
+#include "glm/ext.hpp"
+#include "glm/gtx/euler_angles.hpp"
+#include "glm/gtx/scalar_multiplication.hpp"
+#include "glm/gtx/vector_angle.hpp"
+#include "glm/gtx/rotate_vector.hpp"
+#include "glm/gtx/spline.hpp"
+#include "glm/gtx/intersect.hpp"
+#include "Utilities/GLMExtensions.hpp"
@@ -0,0 +1,304 @@
+#include "StdInclude.hpp"
+#include "CameraTrackImporter.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include "KeyframeManager.hpp"
+#include "Utilities/RotationSpline.hpp"
+
+namespace IWXMVM::Components
+{
+    enum class Column
+    {
+        Time,
+        Frame,
+        Tick,
+        X,
+        Y,
+        Z,
+        Pitch,
+        Yaw,
+        Roll,
+        QW,
+        QX,
+        QY,
+        QZ,
+        Fov,
+        FocalLength,
+        Count,
+    };
+
+    constexpr std::array<std::string_view, static_cast<std::size_t>(Column::Count)> COLUMN_NAMES = {
+        "time", "frame", "tick", "x", "y", "z", "pitch", "yaw", "roll", "qw", "qx", "qy", "qz", "fov", "focal_length",
+    };
+
+    // horizontal size of a full frame sensor in mm, for converting focal lengths to a field of view
+    constexpr float SENSOR_WIDTH = 36.0f;
+
+    using Sample = std::array<std::optional<float>, static_cast<std::size_t>(Column::Count)>;
+    using SampleHandler = std::function<void(const Sample& sample)>;
+
+    std::string_view Trim(std::string_view string)
+    {
+        const auto first = string.find_first_not_of(" \t\r\"");
+        if (first == std::string_view::npos)
+            return {};
+        const auto last = string.find_last_not_of(" \t\r\"");
+        return string.substr(first, last - first + 1);
+    }
+
+    std::optional<Column> GetColumn(std::string_view name)
+    {
+        std::string lowercaseName(Trim(name));
+        std::transform(lowercaseName.begin(), lowercaseName.end(), lowercaseName.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        for (std::size_t i = 0; i < COLUMN_NAMES.size(); i++)
+        {
+            if (COLUMN_NAMES[i] == lowercaseName)
+                return static_cast<Column>(i);
+        }
+        return std::nullopt;
+    }
+
+    glm::vec3 ConvertAxes(glm::vec3 vector, CameraTrackImporter::UpAxis upAxis)
+    {
+        // the game is z-up; y-up files are rotated by 90 degrees around x, which keeps their handedness
+        if (upAxis == CameraTrackImporter::UpAxis::Y)
+            return glm::vec3(vector.x, -vector.z, vector.y);
+        return vector;
+    }
+
+    std::optional<std::pair<uint32_t, Types::CameraData>> ConvertSample(const Sample& sample,
+                                                                        const CameraTrackImporter::Settings& settings)
+    {
+        auto Get = [&](Column column) { return sample[static_cast<std::size_t>(column)]; };
+        auto HasAll = [&](std::initializer_list<Column> columns) {
+            return std::all_of(columns.begin(), columns.end(), [&](Column column) { return Get(column).has_value(); });
+        };
+
+        std::optional<double> time;
+        if (HasAll({Column::Tick}))
+            time = *Get(Column::Tick);
+        else if (HasAll({Column::Frame}))
+            time = *Get(Column::Frame) / std::max(settings.frameRate, 1.0f) * 1000.0;
+        else if (HasAll({Column::Time}))
+            time = *Get(Column::Time) * 1000.0;
+
+        if (!time.has_value() || !HasAll({Column::X, Column::Y, Column::Z}))
+            return std::nullopt;
+
+        const auto tick = std::llround(*time) + static_cast<long long>(settings.startTick);
+        if (tick < 0 || tick > (std::numeric_limits<uint32_t>::max)())
+            return std::nullopt;
+
+        Types::CameraData node;
+        node.position = ConvertAxes(glm::vec3(*Get(Column::X), *Get(Column::Y), *Get(Column::Z)) * settings.unitScale,
+                                    settings.upAxis);
+
+        if (HasAll({Column::Pitch, Column::Yaw, Column::Roll}))
+        {
+            // they are in the game's convention, which only has a meaning for z-up files
+            if (settings.upAxis != CameraTrackImporter::UpAxis::Z)
+                throw std::runtime_error("Euler angles can only be imported from z-up files, use quaternions instead");
+
+            node.rotation = glm::vec3(*Get(Column::Pitch), *Get(Column::Yaw), *Get(Column::Roll));
+            if (settings.anglesInRadians)
+                node.rotation = glm::degrees(node.rotation);
+        }
+        else if (HasAll({Column::QW, Column::QX, Column::QY, Column::QZ}))
+        {
+            const auto rotation =
+                glm::normalize(glm::quat(*Get(Column::QW), *Get(Column::QX), *Get(Column::QY), *Get(Column::QZ)));
+            const auto forward = ConvertAxes(rotation * glm::vec3(0.0f, 0.0f, -1.0f), settings.upAxis);
+            const auto up = ConvertAxes(rotation * glm::vec3(0.0f, 1.0f, 0.0f), settings.upAxis);
+            const auto left = glm::cross(up, forward);
+            node.rotation = MathUtils::AnglesFromQuaternion(glm::quat_cast(glm::mat3(forward, left, up)));
+        }
+        else
+        {
+            return std::nullopt;
+        }
+
+        if (HasAll({Column::Fov}))
+            node.fov = settings.anglesInRadians ? glm::degrees(*Get(Column::Fov)) : *Get(Column::Fov);
+        else if (HasAll({Column::FocalLength}) && *Get(Column::FocalLength) > 0.0f)
+            node.fov = glm::degrees(2.0f * std::atan(SENSOR_WIDTH / (2.0f * *Get(Column::FocalLength))));
+        else
+            node.fov = 90.0f;
+
+        return std::make_pair(static_cast<uint32_t>(tick), node);
+    }
+
+    void ReadCsv(std::istream& file, const SampleHandler& handleSample)
+    {
+        std::string line;
+        if (!std::getline(file, line))
+            throw std::runtime_error("File is empty");
+
+        char delimiter = ',';
+        if (line.find(';') != std::string::npos)
+            delimiter = ';';
+        else if (line.find('\t') != std::string::npos)
+            delimiter = '\t';
+
+        auto ForEachField = [delimiter](std::string_view line, auto&& handleField) {
+            std::size_t index = 0;
+            while (true)
+            {
+                const auto end = line.find(delimiter);
+                handleField(index++, Trim(line.substr(0, end)));
+                if (end == std::string_view::npos)
+                    break;
+                line.remove_prefix(end + 1);
+            }
+        };
+
+        std::vector<std::optional<Column>> columns;
+        ForEachField(line, [&](std::size_t, std::string_view name) { columns.push_back(GetColumn(name)); });
+
+        Sample sample;
+        while (std::getline(file, line))
+        {
+            if (Trim(line).empty() || line.front() == '#')
+                continue;
+
+            sample.fill(std::nullopt);
+            ForEachField(line, [&](std::size_t index, std::string_view field) {
+                if (index >= columns.size() || !columns[index].has_value())
+                    return;
+
+                float value;
+                const auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+                if (result.ec == std::errc())
+                    sample[static_cast<std::size_t>(*columns[index])] = value;
+            });
+
+            handleSample(sample);
+        }
+    }
+
+    void ReadJsonLines(std::istream& file, const SampleHandler& handleSample)
+    {
+        std::string line;
+        Sample sample;
+        while (std::getline(file, line))
+        {
+            if (Trim(line).empty())
+                continue;
+
+            sample.fill(std::nullopt);
+
+            const auto object = nlohmann::json::parse(line, nullptr, false);
+            if (object.is_object())
+            {
+                auto SetFromArray = [&](const nlohmann::json& array, std::initializer_list<Column> columns) {
+                    if (!array.is_array() || array.size() != columns.size())
+                        return;
+                    std::size_t i = 0;
+                    for (const auto column : columns)
+                    {
+                        if (array[i].is_number())
+                            sample[static_cast<std::size_t>(column)] = array[i].get<float>();
+                        i++;
+                    }
+                };
+
+                for (const auto& [key, value] : object.items())
+                {
+                    if (key == "position")
+                        SetFromArray(value, {Column::X, Column::Y, Column::Z});
+                    else if (key == "rotation")
+                        SetFromArray(value, {Column::Pitch, Column::Yaw, Column::Roll});
+                    else if (key == "quaternion")
+                        SetFromArray(value, {Column::QW, Column::QX, Column::QY, Column::QZ});
+                    else if (const auto column = GetColumn(key); column.has_value() && value.is_number())
+                        sample[static_cast<std::size_t>(*column)] = value.get<float>();
+                }
+            }
+
+            // lines that aren't valid are counted as skipped samples
+            handleSample(sample);
+        }
+    }
+
+    std::size_t CameraTrackImporter::Import(const std::filesystem::path& path, const Settings& settings)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Failed to open camera track at {}", path.string());
+            return 0;
+        }
+
+        auto& keyframeManager = KeyframeManager::Get();
+        const auto& property = keyframeManager.GetProperty(Types::KeyframeablePropertyType::CampathCamera);
+
+        std::vector<Types::Keyframe> keyframes;
+        std::size_t skippedCount = 0;
+        auto AddSample = [&](const Sample& sample) {
+            const auto node = ConvertSample(sample, settings);
+            if (!node.has_value())
+            {
+                skippedCount++;
+                return;
+            }
+
+            // samples that are less than a tick apart end up on the same tick, the last one of them is kept
+            if (!keyframes.empty() && keyframes.back().tick == node->first)
+                keyframes.back().value = node->second;
+            else
+                keyframes.emplace_back(property, node->first, node->second);
+        };
+
+        try
+        {
+            const auto extension = path.extension();
+            if (extension == ".jsonl" || extension == ".ndjson")
+                ReadJsonLines(file, AddSample);
+            else
+                ReadCsv(file, AddSample);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Failed to import camera track ({})", e.what());
+            return 0;
+        }
+
+        if (skippedCount > 0)
+            LOG_WARN("Skipped {} samples of {} that were incomplete or out of range", skippedCount, path.string());
+
+        // same as above for samples that were out of order
+        std::stable_sort(keyframes.begin(), keyframes.end(),
+                         [](const auto& a, const auto& b) { return a.tick < b.tick; });
+        std::size_t uniqueCount = 0;
+        for (std::size_t i = 0; i < keyframes.size(); i++)
+        {
+            if (uniqueCount > 0 && keyframes[uniqueCount - 1].tick == keyframes[i].tick)
+                keyframes[uniqueCount - 1] = keyframes[i];
+            else
+                keyframes[uniqueCount++] = keyframes[i];
+        }
+        keyframes.erase(keyframes.begin() + uniqueCount, keyframes.end());
+
+        // nodes that were placed before are kept
+        auto& campathKeyframes = keyframeManager.GetKeyframes(property);
+        std::unordered_set<uint32_t> existingTicks;
+        for (const auto& keyframe : campathKeyframes)
+            existingTicks.insert(keyframe.tick);
+        std::erase_if(keyframes, [&](const auto& k) { return existingTicks.contains(k.tick); });
+
+        const auto importedCount = keyframes.size();
+        if (importedCount == 0)
+        {
+            LOG_WARN("No camera nodes to import from {}", path.string());
+            return 0;
+        }
+
+        // sorts the campath before it is saved
+        keyframeManager.AddKeyframes(property, std::move(keyframes));
+
+        LOG_INFO("Imported {} camera nodes from {}", importedCount, path.string());
+        return importedCount;
+    }
+}  // namespace IWXMVM::Components
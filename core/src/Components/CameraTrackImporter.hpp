@@ -0,0 +1,31 @@
+#pragma once
+
+namespace IWXMVM::Components
+{
+    // Imports camera animation from external tools into the campath. Files are either CSV with a header row or JSON
+    // lines with one object per sample, both using the same column names:
+    //   time (seconds), frame or tick; x, y, z; pitch, yaw, roll or qw, qx, qy, qz; optionally fov or focal_length
+    // Quaternions describe a camera looking down its local -z axis with +y up, as in most 3D packages; euler angles
+    // are expected in the game's convention, so y-up files have to use quaternions. Files are read line by line, so
+    // only the imported nodes are kept in memory.
+    namespace CameraTrackImporter
+    {
+        enum class UpAxis
+        {
+            Z,
+            Y,
+        };
+
+        struct Settings
+        {
+            UpAxis upAxis = UpAxis::Z;
+            float unitScale = 1.0f;  // game units per unit in the file
+            float frameRate = 30.0f;  // for files that are timed in frames
+            bool anglesInRadians = false;
+            uint32_t startTick = 0;  // where time 0 of the file ends up
+        };
+
+        // Picks the format based on the file extension, returns the number of imported nodes
+        std::size_t Import(const std::filesystem::path& path, const Settings& settings);
+    }  // namespace CameraTrackImporter
+}  // namespace IWXMVM::Components
@@ -13,6 +13,9 @@ namespace IWXMVM::Components
     {
         if (Mod::GetGameInterface()->GetGameState() != Types::GameState::InDemo)
         {
+            // keep what was recorded up to leaving the demo
+            if (isRecording)
+                StopRecording();
             return;
         }
 
@@ -25,6 +28,24 @@ namespace IWXMVM::Components
         {
             const auto& property = KeyframeManager::Get().GetProperty(Types::KeyframeablePropertyType::CampathCamera);
 
+            if (Input::BindDown(Action::DollyRecordPath))
+            {
+                if (isRecording)
+                    StopRecording();
+                else
+                    StartRecording();
+            }
+
+            if (isRecording)
+            {
+                Types::CameraData node;
+                node.position = activeCamera->GetPosition();
+                node.rotation = activeCamera->GetRotation();
+                node.fov = activeCamera->GetFov();
+
+                RecordSample(Components::Playback::GetTimelineTick(), node);
+            }
+
             if (Input::BindDown(Action::DollyAddNode))
             {
                 const auto tick = Components::Playback::GetTimelineTick();
@@ -88,6 +109,10 @@ namespace IWXMVM::Components
         }
         else
         {
+            // the dolly camera can't record itself
+            if (isRecording)
+                StopRecording();
+
             if (Input::BindDown(Action::DollyPlayPath))
             {
                 CameraManager::Get().SetActiveCamera(CameraManager::Get().GetPreviousActiveCamera()->GetMode());
@@ -99,8 +124,97 @@ namespace IWXMVM::Components
         }
     }
 
+    void CampathManager::StartRecording()
+    {
+        // allocated once, so recording never allocates while the demo is playing
+        if (recordingBuffer.empty())
+            recordingBuffer.resize(RECORDING_CAPACITY);
+
+        recordingStart = 0;
+        recordedSampleCount = 0;
+        droppedSampleCount = 0;
+        isRecording = true;
+
+        LOG_INFO("Started recording campath");
+    }
+
+    void CampathManager::StopRecording()
+    {
+        isRecording = false;
+
+        auto& keyframeManager = KeyframeManager::Get();
+        const auto& property = keyframeManager.GetProperty(Types::KeyframeablePropertyType::CampathCamera);
+        auto& keyframes = keyframeManager.GetKeyframes(property);
+
+        // nodes that were placed before are kept
+        std::unordered_set<uint32_t> existingTicks;
+        for (const auto& keyframe : keyframes)
+            existingTicks.insert(keyframe.tick);
+
+        std::vector<Types::Keyframe> recordedKeyframes;
+        recordedKeyframes.reserve(recordedSampleCount);
+        for (std::size_t i = 0; i < recordedSampleCount; i++)
+        {
+            const auto& sample = recordingBuffer[(recordingStart + i) % RECORDING_CAPACITY];
+            if (!existingTicks.contains(sample.tick))
+                recordedKeyframes.emplace_back(property, sample.tick, sample.node);
+        }
+        recordedSampleCount = 0;
+
+        if (droppedSampleCount > 0)
+        {
+            LOG_WARN("Campath recording exceeded {} samples, the first {} samples were dropped", RECORDING_CAPACITY,
+                     droppedSampleCount);
+        }
+
+        if (recordedKeyframes.empty())
+        {
+            LOG_INFO("Stopped recording campath, no nodes were recorded");
+            return;
+        }
+
+        // the track is kept at one node per tick, reducing it is left to the user
+        const auto recordedCount = recordedKeyframes.size();
+        keyframeManager.AddKeyframes(property, std::move(recordedKeyframes));
+
+        LOG_INFO("Stopped recording campath, recorded {} nodes", recordedCount);
+    }
+
+    void CampathManager::RecordSample(uint32_t tick, const Types::CameraData& node)
+    {
+        if (recordedSampleCount > 0)
+        {
+            auto GetLastSample = [&]() -> RecordedSample& {
+                return recordingBuffer[(recordingStart + recordedSampleCount - 1) % RECORDING_CAPACITY];
+            };
+
+            // nothing to record while the demo is paused
+            if (GetLastSample().tick == tick)
+                return;
+
+            // after rewinding, the new pass replaces whatever was recorded past the current tick
+            while (recordedSampleCount > 0 && GetLastSample().tick >= tick)
+                recordedSampleCount--;
+        }
+
+        if (recordedSampleCount == RECORDING_CAPACITY)
+        {
+            recordingStart = (recordingStart + 1) % RECORDING_CAPACITY;
+            recordedSampleCount--;
+            droppedSampleCount++;
+        }
+
+        recordingBuffer[(recordingStart + recordedSampleCount) % RECORDING_CAPACITY] = {tick, node};
+        recordedSampleCount++;
+    }
+
     void CampathManager::Initialize()
     {
         Events::RegisterListener(EventType::OnFrame, [&]() { Update(); });
+        Events::RegisterListener(EventType::PreDemoLoad, [&]() {
+            // still part of the previous demo, whose journal is only closed once the new one is loaded
+            if (isRecording)
+                StopRecording();
+        });
     }
 }  // namespace IWXMVM::Components
@@ -1,4 +1,5 @@
 #pragma once
+#include "Types/Keyframe.hpp"
 
 namespace IWXMVM::Components
 {
@@ -18,9 +19,35 @@ namespace IWXMVM::Components
         void Initialize();
         void Update();
 
+        // Samples the active camera into the campath every time the demo advances to a new tick. Stopping, or
+        // leaving the demo, commits one node per recorded tick as a single undoable action.
+        void StartRecording();
+        void StopRecording();
+        bool IsRecording() const
+        {
+            return isRecording;
+        }
+
        private:
         CampathManager()
         {
         }
+
+        struct RecordedSample
+        {
+            uint32_t tick;
+            Types::CameraData node;
+        };
+
+        // once full, the oldest samples are overwritten
+        static constexpr std::size_t RECORDING_CAPACITY = 1 << 16;
+
+        void RecordSample(uint32_t tick, const Types::CameraData& node);
+
+        bool isRecording = false;
+        std::vector<RecordedSample> recordingBuffer;
+        std::size_t recordingStart = 0;
+        std::size_t recordedSampleCount = 0;
+        std::size_t droppedSampleCount = 0;
     };
 }  // namespace IWXMVM::Components
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Utilities/PathUtils.hpp"
 #include "D3D9.hpp"
 #include "Events.hpp"
+#include "Utilities/Profiler.hpp"
 
 namespace IWXMVM::Components
 {
@@ -97,7 +98,7 @@ namespace IWXMVM::Components
             OutputFormat::Video, 
             VideoCodec::Prores4444,
             gameResolution,
-            250
+            {250}
         };
 
         auto& outputDirectory = PreferencesConfiguration::Get().captureOutputDirectory;
@@ -106,10 +107,10 @@ namespace IWXMVM::Components
             outputDirectory = std::filesystem::path(PathUtils::GetCurrentGameDirectory()) / "IWXMVM" / "recordings";
         }
 
-        Events::RegisterListener(EventType::OnDemoBoundsDetermined, [&]() {
+        Events::RegisterListener<EventType::OnDemoBoundsDetermined>([&](const DemoBounds& bounds) {
             if (captureSettings.startTick == 0 || captureSettings.endTick == 0)
             {
-                auto endTick = Mod::GetGameInterface()->GetDemoInfo().endTick;
+                auto endTick = bounds.endTick;
                 captureSettings.startTick = static_cast<int32_t>(endTick * 0.1);
                 captureSettings.endTick = static_cast<int32_t>(endTick * 0.9);
             }
@@ -120,6 +121,8 @@ namespace IWXMVM::Components
 
     void CaptureManager::CaptureFrame()
     {
+        PROFILE_FUNCTION();
+
         framePrepared = false;
 
         FILE* outputPipe = pipe;
@@ -176,6 +179,8 @@ namespace IWXMVM::Components
 
     void CaptureManager::PrepareFrame()
     {
+        PROFILE_FUNCTION();
+
         if (!isCapturing.load())
         	return;
 
@@ -198,14 +203,25 @@ namespace IWXMVM::Components
 
     int32_t CaptureManager::OnGameFrame()
     {
-        if (MultiPassEnabled())
+        // every pass of a multi-pass capture renders the same tick
+        if (MultiPassEnabled() && capturedFrameCount % captureSettings.passes.size() != 0)
         {
-            return capturedFrameCount % captureSettings.passes.size() == 0 ? 1000 / GetCaptureSettings().framerate : 0;
+            return 0;
         }
-        else
+
+        const auto framerate = GetCaptureSettings().framerate;
+
+        // with a keyframed playback speed, every captured frame covers the same amount of output time instead of the
+        // same amount of demo time
+        const auto remappedDelta = Playback::CalculateRemappedDelta(1000.0 / framerate.ToDouble());
+        if (remappedDelta.has_value())
         {
-            return 1000 / GetCaptureSettings().framerate;
+            return remappedDelta.value();
         }
+
+        const auto delta = frameClock.Advance();
+        Playback::SetTickFraction(Playback::GetTimelineTick() + delta, frameClock.GetTickFraction());
+        return delta;
     }
 
     void CaptureManager::ToggleCapture()
@@ -236,10 +252,11 @@ namespace IWXMVM::Components
         {
             case OutputFormat::ImageSequence:
                 return std::format(
-                    "{} -f rawvideo -pix_fmt bgra -s {}x{} -r {} -i - -q:v 0 "
+                    "{} -f rawvideo -pix_fmt bgra -s {}x{} -r {}/{} -i - -q:v 0 "
                     "-vf scale={}:{} -y \"{}\\output_{}_%06d.tga\" 2>&1",
                     shortPath,
-                    screenDimensions.width, screenDimensions.height, captureSettings.framerate,
+                    screenDimensions.width, screenDimensions.height, captureSettings.framerate.numerator,
+                    captureSettings.framerate.denominator,
                     captureSettings.resolution.width, captureSettings.resolution.height, outputDirectory.string(), passIndex);
             case OutputFormat::Video:
             {
@@ -283,9 +300,10 @@ namespace IWXMVM::Components
                 }
 
                 return std::format(
-                    "{} -f rawvideo -pix_fmt bgra -s {}x{} -r {} -i - -c:v prores -profile:v {} -q:v 1 "
+                    "{} -f rawvideo -pix_fmt bgra -s {}x{} -r {}/{} -i - -c:v prores -profile:v {} -q:v 1 "
                     "-pix_fmt {} -vf scale={}:{} -y \"{}\\{}\" 2>&1",
-                    shortPath, screenDimensions.width, screenDimensions.height, captureSettings.framerate, profile,
+                    shortPath, screenDimensions.width, screenDimensions.height, captureSettings.framerate.numerator,
+                    captureSettings.framerate.denominator, profile,
                     pixelFormat, captureSettings.resolution.width, captureSettings.resolution.height, outputDirectory.string(), filename);
             }
             default:
@@ -314,8 +332,10 @@ namespace IWXMVM::Components
         Playback::SetTickDelta(captureSettings.startTick - currentTick, true);
 
         capturedFrameCount = 0;
+        frameClock.Reset(captureSettings.framerate.numerator, captureSettings.framerate.denominator);
 
-        LOG_INFO("Starting capture at {0} ({1} fps)", captureSettings.resolution.ToString(), captureSettings.framerate);
+        LOG_INFO("Starting capture at {0} ({1} fps)", captureSettings.resolution.ToString(),
+                 captureSettings.framerate.ToString());
 
         IDirect3DDevice9* device = D3D9::GetDevice();
 
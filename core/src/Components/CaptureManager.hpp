@@ -1,6 +1,7 @@
 #pragma once
 #include "Camera.hpp"
 #include "Types/RenderingFlags.hpp"
+#include "Utilities/FrameClock.hpp"
 
 namespace IWXMVM::Components
 {
@@ -54,6 +55,28 @@ namespace IWXMVM::Components
         }
     };
 
+    // Frames per second as a fraction, so that NTSC rates like 24000 / 1001 are exact
+    struct Framerate
+    {
+        int32_t numerator;
+        int32_t denominator = 1;
+
+        bool operator==(const Framerate& other) const
+        {
+            return numerator == other.numerator && denominator == other.denominator;
+        }
+
+        double ToDouble() const
+        {
+            return static_cast<double>(numerator) / denominator;
+        }
+
+        std::string ToString() const
+        {
+            return denominator == 1 ? std::to_string(numerator) : std::format("{:.5g}", ToDouble());
+        }
+    };
+
     enum class VideoCodec
     {
         Prores4444XQ,
@@ -73,7 +96,7 @@ namespace IWXMVM::Components
         std::optional<VideoCodec> videoCodec;
 
         Resolution resolution;
-        int32_t framerate;
+        Framerate framerate;
 
         std::vector<PassData> passes;
     };
@@ -120,9 +143,10 @@ namespace IWXMVM::Components
             return supportedResolutions;
         }
 
-        std::array<int32_t, 6> GetSupportedFramerates()
+        std::array<Framerate, 15> GetSupportedFramerates()
         {
-            return { 50, 100, 125, 250, 500, 1000 };
+            return {{{24000, 1001}, {24}, {25}, {30000, 1001}, {30}, {50}, {60000, 1001}, {60}, {100}, {120}, {125},
+                     {240}, {250}, {500}, {1000}}};
         }
 
         bool IsCapturing() const
@@ -177,6 +201,7 @@ namespace IWXMVM::Components
         IDirect3DSurface9* tempSurface = nullptr;
         std::atomic_bool isCapturing = false;
         std::int32_t capturedFrameCount = 0;
+        MathUtils::FrameClock frameClock;
         bool ffmpegNotFound = false;
         bool framePrepared = false;
         FILE* pipe = nullptr;
@@ -0,0 +1,83 @@
+#include "StdInclude.hpp"
+#include "DemoReadTrace.hpp"
+
+#include "Mod.hpp"
+#include "Events.hpp"
+#include "Utilities/PathUtils.hpp"
+
+namespace IWXMVM::Components::DemoReadTrace
+{
+    std::optional<DemoReads::TraceRecorder> recorder;
+
+    void StartRecording()
+    {
+        if (recorder.has_value())
+            return;
+
+        const auto demoPath = Mod::GetGameInterface()->GetDemoInfo().path;
+        recorder.emplace(demoPath);
+
+        LOG_INFO("Recording demo reads of {}", demoPath);
+    }
+
+    void StopRecording()
+    {
+        if (!recorder.has_value())
+            return;
+
+        const auto path = GetTracePath();
+        std::filesystem::create_directories(path.parent_path());
+
+        if (recorder->WriteFile(path))
+        {
+            LOG_INFO("Wrote {} demo reads ({} bytes) to {}", recorder->GetReadCount(), recorder->GetRecordSize(),
+                     path.string());
+        }
+        else
+        {
+            LOG_ERROR("Failed to write demo read trace {}", path.string());
+        }
+
+        recorder.reset();
+    }
+
+    bool IsRecording()
+    {
+        return recorder.has_value();
+    }
+
+    void RecordRead(uint32_t offset, uint32_t filePosition, uint32_t length, int32_t serverTime)
+    {
+        if (recorder.has_value())
+            recorder->Record(offset, filePosition, length, serverTime);
+    }
+
+    std::filesystem::path GetTracePath()
+    {
+        return PathUtils::GetIWXMVMPath() / "demo-reads.trace";
+    }
+
+    std::optional<DemoReads::ReplayResult> Replay(const std::filesystem::path& path)
+    {
+        std::string error;
+        auto result = DemoReads::Replay(path, {}, error);
+        if (!result.has_value())
+        {
+            LOG_ERROR("{}", error);
+            return std::nullopt;
+        }
+
+        for (const auto& violation : result->violations)
+            LOG_WARN("{}", violation);
+
+        LOG_INFO("Replayed {} demo reads ({} seeks, {} bytes) in {:.2f} ms with {} invariant violations",
+                 result->readCount, result->seekCount, result->byteCount, result->milliseconds,
+                 result->violationCount);
+        return result;
+    }
+
+    void Initialize()
+    {
+        Events::RegisterListener(EventType::PreDemoLoad, StopRecording);
+    }
+}  // namespace IWXMVM::Components::DemoReadTrace
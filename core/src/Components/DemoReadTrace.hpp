@@ -0,0 +1,24 @@
+#pragma once
+#include "Utilities/DemoReads.hpp"
+
+namespace IWXMVM::Components
+{
+    // Records every read the game makes from the demo file, so a sequence of reads that led to a rewinding bug or
+    // slowdown can be replayed against the same demo outside of a playback session. The trace format and the replayer
+    // are in Utilities/DemoReads, which can also be built without the game.
+    namespace DemoReadTrace
+    {
+        void StartRecording();
+        void StopRecording();  // writes the trace file
+        bool IsRecording();
+        // offset is where Rewinding believes the read starts, filePosition where the demo file actually is
+        void RecordRead(uint32_t offset, uint32_t filePosition, uint32_t length, int32_t serverTime);
+
+        std::filesystem::path GetTracePath();
+
+        // Replays a trace against the demo it was recorded with and logs the result
+        std::optional<DemoReads::ReplayResult> Replay(const std::filesystem::path& path);
+
+        void Initialize();
+    }  // namespace DemoReadTrace
+}  // namespace IWXMVM::Components
@@ -11,6 +11,37 @@ namespace IWXMVM::Components
     {
     }
 
+    float DollyCamera::GetConstantSpeedTick(const Types::KeyframeableProperty& property,
+                                            const std::vector<Types::Keyframe>& keyframes, float tick)
+    {
+        if (keyframes.size() < 2 || tick <= keyframes.front().tick || tick >= keyframes.back().tick)
+            return tick;
+
+        auto& keyframeManager = KeyframeManager::Get();
+
+        const auto revision = keyframeManager.GetKeyframesRevision(property);
+        if (arcLengthTableRevision != revision)
+        {
+            // the keyframe manager switches to cubic interpolation at 4 nodes
+            const bool isCubicPath = keyframes.size() >= 4;
+            const auto& segmentTable = keyframeManager.GetSegmentTable(property);
+            arcLengthTable.Update(
+                keyframes, [&](float t) { return segmentTable.EvaluateVector3Derivative(t); },
+                isCubicPath != wasCubicPath);
+            wasCubicPath = isCubicPath;
+            arcLengthTableRevision = revision;
+        }
+
+        if (arcLengthTable.GetTotalLength() <= 0.0f)
+            return tick;
+
+        // keep the duration of the path, but spread the distance evenly over it
+        const auto startTick = static_cast<float>(keyframes.front().tick);
+        const auto endTick = static_cast<float>(keyframes.back().tick);
+        const auto progress = (tick - startTick) / (endTick - startTick);
+        return arcLengthTable.GetTickAtDistance(progress * arcLengthTable.GetTotalLength());
+    }
+
     void DollyCamera::Update()
     {
         if (Rewinding::IsRewinding() )
@@ -19,11 +50,15 @@ namespace IWXMVM::Components
         auto& keyframeManager = KeyframeManager::Get();
         const auto& property = keyframeManager.GetProperty(Types::KeyframeablePropertyType::CampathCamera);
 
-        if (keyframeManager.GetKeyframes(property).empty())
+        const auto& keyframes = keyframeManager.GetKeyframes(property);
+        if (keyframes.empty())
             return;
 
-        const auto currentTick = Playback::GetTimelineTick();
-        const auto interpolatedValue = keyframeManager.Interpolate(property, currentTick);
+        auto currentTick = static_cast<float>(Playback::GetPreciseTimelineTick());
+        if (useConstantSpeed)
+            currentTick = GetConstantSpeedTick(property, keyframes, currentTick);
+
+        const auto interpolatedValue = keyframeManager.Interpolate(property, keyframes, currentTick);
 
         this->GetPosition() = interpolatedValue.cameraData.position;
         this->GetRotation() = interpolatedValue.cameraData.rotation;
@@ -1,5 +1,6 @@
 #pragma once
 #include "Camera.hpp"
+#include "Utilities/ArcLengthTable.hpp"
 
 namespace IWXMVM::Components
 {
@@ -13,5 +14,20 @@ namespace IWXMVM::Components
 
         void Initialize() override;
         void Update() override;
+
+        bool& UseConstantSpeed()
+        {
+            return useConstantSpeed;
+        }
+
+       private:
+        bool useConstantSpeed = false;
+
+        MathUtils::ArcLengthTable arcLengthTable;
+        std::optional<uint32_t> arcLengthTableRevision;
+        bool wasCubicPath = false;
+
+        float GetConstantSpeedTick(const Types::KeyframeableProperty& property,
+                                   const std::vector<Types::Keyframe>& keyframes, float tick);
     };
 }  // namespace IWXMVM::Components
\ No newline at end of file
@@ -0,0 +1,404 @@
+#include "StdInclude.hpp"
+#include "KeyframeJournal.hpp"
+
+#include "KeyframeManager.hpp"
+#include "KeyframeSerializer.hpp"
+
+namespace IWXMVM::Components
+{
+    constexpr std::array<char, 4> JOURNAL_MAGIC = {'I', 'W', 'X', 'J'};
+    // 2: snapshots are always sorted by tick, so their keyframes keep their positions when they are loaded
+    // 3: interpolation parameters are only written for keyframes that have them
+    constexpr uint32_t JOURNAL_VERSION = 3;
+
+    constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(250);
+    constexpr std::size_t COMPACT_JOURNAL_SIZE = 4 * 1024 * 1024;
+
+    // Written at the start of every journal. Identifies the snapshot the journal applies to, along with the ids its
+    // keyframes had when it was written, since keyframe ids are not persistent.
+    struct JournalHeader
+    {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint64_t snapshotSize;
+        uint64_t snapshotHash;
+        uint32_t trackCount;
+        // followed by the property type, the keyframe count and the keyframe ids of every track
+    };
+
+    enum class RecordType : uint32_t
+    {
+        Upsert,
+        Removal,
+    };
+
+    struct RecordHeader
+    {
+        RecordType type;
+        uint32_t propertyType;
+        int32_t id;
+    };
+
+    struct UpsertRecord
+    {
+        uint32_t tick;
+        std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT> values;
+        Types::KeyframeInterpolationMode mode;
+        uint32_t hasParameters;
+        // followed by the interpolation parameters, if there are any
+    };
+    static_assert(std::is_trivially_copyable_v<UpsertRecord>);
+    static_assert(std::is_trivially_copyable_v<Types::KeyframeInterpolation::Parameters>);
+
+    uint64_t HashBytes(std::span<const char> bytes)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (const char byte : bytes)
+        {
+            hash ^= static_cast<uint8_t>(byte);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    void AppendBytes(std::vector<char>& buffer, const T& value)
+    {
+        const auto bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::optional<std::vector<char>> ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            return std::nullopt;
+
+        std::vector<char> data(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(data.data(), data.size());
+        return data;
+    }
+
+    void WriteFileAtomically(const std::filesystem::path& path, std::span<const char> data)
+    {
+        auto temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+        file.close();
+
+        std::filesystem::rename(temporaryPath, path);
+    }
+
+    void KeyframeJournal::Open()
+    {
+        journalPath = KeyframeSerializer::GetRecentPath().replace_extension(".journal");
+        const bool recoveredEdits = Replay();
+
+        isOpen = true;
+        recordCount = 0;
+        journalSize = 0;
+
+        if (!worker.joinable())
+            worker = std::thread([this] { RunWorker(); });
+
+        // the snapshot is only written once something is edited, unless there were edits to recover
+        needsSnapshot = true;
+        if (recoveredEdits)
+            Compact();
+    }
+
+    void KeyframeJournal::Close()
+    {
+        // anything already recorded is still written by the worker
+        isOpen = false;
+    }
+
+    void KeyframeJournal::Shutdown()
+    {
+        Close();
+
+        if (!worker.joinable())
+            return;
+
+        {
+            std::lock_guard lock(mutex);
+            stopWorker = true;
+        }
+        condition.notify_one();
+        worker.join();
+    }
+
+    void KeyframeJournal::RecordUpsert(const Types::Keyframe& keyframe)
+    {
+        using Parameters = Types::KeyframeInterpolation::Parameters;
+
+        const auto& interpolation = keyframe.interpolation;
+        UpsertRecord upsert{keyframe.tick, {}, interpolation.mode, interpolation.HasParameters()};
+        for (int32_t i = 0; i < keyframe.property.get().GetValueCount(); i++)
+            upsert.values[i] = keyframe.value.GetByIndex(i);
+
+        std::array<char, sizeof(RecordHeader) + sizeof(UpsertRecord) + sizeof(Parameters)> record;
+        const RecordHeader header{RecordType::Upsert, static_cast<uint32_t>(keyframe.property.get().type),
+                                  keyframe.id};
+        std::memcpy(record.data(), &header, sizeof(header));
+        std::memcpy(record.data() + sizeof(header), &upsert, sizeof(upsert));
+
+        auto recordSize = sizeof(header) + sizeof(upsert);
+        if (upsert.hasParameters)
+        {
+            std::memcpy(record.data() + recordSize, &interpolation.GetParameters(), sizeof(Parameters));
+            recordSize += sizeof(Parameters);
+        }
+        Append(std::span(record).first(recordSize));
+    }
+
+    void KeyframeJournal::RecordRemoval(const Types::Keyframe& keyframe)
+    {
+        const RecordHeader header{RecordType::Removal, static_cast<uint32_t>(keyframe.property.get().type),
+                                  keyframe.id};
+        Append(std::span(reinterpret_cast<const char*>(&header), sizeof(header)));
+    }
+
+    void KeyframeJournal::Append(std::span<const char> record)
+    {
+        if (!isOpen)
+            return;
+
+        if (needsSnapshot)
+        {
+            // the snapshot already contains this change; replaying the record on top of it is harmless
+            Compact();
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            if (tasks.empty() || tasks.back().journalPath != journalPath)
+                tasks.push_back({journalPath, {}, std::nullopt});
+            tasks.back().records.insert(tasks.back().records.end(), record.begin(), record.end());
+        }
+        condition.notify_one();
+
+        recordCount++;
+        journalSize += record.size();
+        if (recordCount >= COMPACT_RECORD_COUNT || journalSize >= COMPACT_JOURNAL_SIZE)
+            Compact();
+    }
+
+    void KeyframeJournal::Compact()
+    {
+        if (!isOpen)
+            return;
+
+        // only the copy is made here, encoding and hashing it is left to the worker
+        auto snapshot = KeyframeSerializer::TakeSnapshot();
+
+        recordCount = 0;
+        journalSize = 0;
+        needsSnapshot = false;
+
+        {
+            std::lock_guard lock(mutex);
+            tasks.push_back({journalPath, {}, std::make_pair(KeyframeSerializer::GetRecentPath(), std::move(snapshot))});
+        }
+        condition.notify_one();
+    }
+
+    bool KeyframeJournal::Replay()
+    {
+        const auto journal = ReadFile(journalPath);
+        if (!journal.has_value())
+            return false;
+
+        std::size_t offset = 0;
+        auto Read = [&](auto& value) {
+            if (sizeof(value) > journal->size() - offset)
+                return false;
+            std::memcpy(&value, journal->data() + offset, sizeof(value));
+            offset += sizeof(value);
+            return true;
+        };
+
+        JournalHeader header;
+        if (!Read(header) || header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION)
+        {
+            LOG_WARN("Ignoring unreadable keyframe journal {}", journalPath.string());
+            return false;
+        }
+
+        const auto snapshot = ReadFile(KeyframeSerializer::GetRecentPath()).value_or(std::vector<char>());
+        if (snapshot.size() != header.snapshotSize || HashBytes(snapshot) != header.snapshotHash)
+        {
+            // a newer snapshot was written, which already contains everything in the journal
+            LOG_DEBUG("Keyframe journal does not belong to the current snapshot, ignoring it");
+            return false;
+        }
+
+        auto& keyframeManager = KeyframeManager::Get();
+
+        try
+        {
+            // maps the ids from the previous session to the position of their keyframe in its track. Removed keyframes
+            // are only erased once all records are replayed, so the positions stay valid until then.
+            std::unordered_map<int32_t, std::size_t> slots;
+            std::unordered_set<int32_t> removedIds;
+            for (uint32_t t = 0; t < header.trackCount; t++)
+            {
+                uint32_t propertyType, keyframeCount;
+                if (!Read(propertyType) || !Read(keyframeCount))
+                    return false;
+
+                const auto& property =
+                    keyframeManager.GetProperty(static_cast<Types::KeyframeablePropertyType>(propertyType));
+                const auto& keyframes = keyframeManager.GetKeyframes(property);
+                if (keyframes.size() != keyframeCount)
+                {
+                    LOG_WARN("Keyframe journal does not match the loaded keyframes, ignoring it");
+                    return false;
+                }
+
+                for (uint32_t i = 0; i < keyframeCount; i++)
+                {
+                    int32_t id;
+                    if (!Read(id))
+                        return false;
+                    slots[id] = i;
+                }
+            }
+
+            // the last record may be incomplete if the game crashed while it was being written
+            std::size_t replayedCount = 0;
+            RecordHeader record;
+            while (Read(record))
+            {
+                const auto& property =
+                    keyframeManager.GetProperty(static_cast<Types::KeyframeablePropertyType>(record.propertyType));
+                auto& keyframes = keyframeManager.GetKeyframes(property);
+
+                // journal ids are unique across all tracks, so the slot always refers to this record's track
+                const auto slot = slots.find(record.id);
+
+                if (record.type == RecordType::Upsert)
+                {
+                    UpsertRecord upsert;
+                    if (!Read(upsert))
+                        break;
+
+                    Types::KeyframeInterpolation interpolation;
+                    interpolation.mode = upsert.mode;
+                    if (upsert.hasParameters && !Read(interpolation.EditParameters()))
+                        break;
+
+                    Types::Keyframe* keyframe;
+                    if (slot != slots.end())
+                    {
+                        keyframe = &keyframes[slot->second];
+                    }
+                    else
+                    {
+                        slots[record.id] = keyframes.size();
+                        keyframe = &keyframes.emplace_back(property);
+                    }
+
+                    keyframe->tick = upsert.tick;
+                    for (int32_t i = 0; i < property.GetValueCount(); i++)
+                        keyframe->value.SetByIndex(i, upsert.values[i]);
+                    keyframe->interpolation = std::move(interpolation);
+                }
+                else if (slot != slots.end())
+                {
+                    removedIds.insert(keyframes[slot->second].id);
+                    slots.erase(slot);
+                }
+
+                replayedCount++;
+            }
+
+            for (const auto& [p, _] : keyframeManager.GetKeyframes())
+            {
+                auto& keyframes = keyframeManager.GetKeyframes(p);
+                std::erase_if(keyframes, [&](const auto& k) { return removedIds.contains(k.id); });
+                keyframeManager.SortAndSaveKeyframes(keyframes);
+            }
+
+            if (replayedCount > 0)
+                LOG_INFO("Recovered {} keyframe edits from the last session", replayedCount);
+            return replayedCount > 0;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Failed to replay keyframe journal ({})", e.what());
+            return false;
+        }
+    }
+
+    void KeyframeJournal::RunWorker()
+    {
+        while (true)
+        {
+            std::deque<WriteTask> currentTasks;
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [&] { return !tasks.empty() || stopWorker; });
+
+                // give more edits the chance to pile up, so they end up in a single write
+                condition.wait_for(lock, FLUSH_INTERVAL, [&] { return stopWorker; });
+
+                currentTasks.swap(tasks);
+            }
+
+            WriteTasks(currentTasks);
+
+            std::lock_guard lock(mutex);
+            if (stopWorker && tasks.empty())
+                return;
+        }
+    }
+
+    void KeyframeJournal::WriteTasks(const std::deque<WriteTask>& currentTasks)
+    {
+        for (const auto& task : currentTasks)
+        {
+            try
+            {
+                if (!std::filesystem::exists(task.journalPath.parent_path()))
+                    std::filesystem::create_directories(task.journalPath.parent_path());
+
+                if (task.snapshot.has_value())
+                {
+                    const auto& [snapshotPath, snapshot] = *task.snapshot;
+                    const auto encodedSnapshot = KeyframeSerializer::WriteBinary(snapshot);
+
+                    std::vector<char> journal;
+                    AppendBytes(journal, JournalHeader{JOURNAL_MAGIC, JOURNAL_VERSION, encodedSnapshot.size(),
+                                                       HashBytes(encodedSnapshot),
+                                                       static_cast<uint32_t>(snapshot.keyframes.size())});
+                    for (const auto& [p, ks] : snapshot.keyframes)
+                    {
+                        AppendBytes(journal, static_cast<uint32_t>(p.type));
+                        AppendBytes(journal, static_cast<uint32_t>(ks.size()));
+                        for (const auto& k : ks)
+                            AppendBytes(journal, k.id);
+                    }
+                    journal.insert(journal.end(), task.records.begin(), task.records.end());
+
+                    // snapshot first: a crash in between leaves a journal that no longer matches and is ignored
+                    WriteFileAtomically(snapshotPath, encodedSnapshot);
+                    WriteFileAtomically(task.journalPath, journal);
+                }
+                else
+                {
+                    std::ofstream file(task.journalPath, std::ios::binary | std::ios::app);
+                    file.write(task.records.data(), task.records.size());
+                }
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Failed to write keyframe journal ({})", e.what());
+            }
+        }
+    }
+}  // namespace IWXMVM::Components
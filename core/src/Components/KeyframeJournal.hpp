@@ -0,0 +1,69 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "KeyframeSerializer.hpp"
+
+namespace IWXMVM::Components
+{
+    // Crash recovery for keyframe edits. Every change applied through the KeyframeManager is appended to a journal
+    // next to the last session's snapshot (see KeyframeSerializer::GetRecentPath). Once the journal grows large
+    // enough it is compacted into a new snapshot. Disk writes are batched and done on a background thread.
+    class KeyframeJournal
+    {
+       public:
+        static KeyframeJournal& Get()
+        {
+            static KeyframeJournal instance;
+            return instance;
+        }
+
+        KeyframeJournal(KeyframeJournal const&) = delete;
+        void operator=(KeyframeJournal const&) = delete;
+
+        // Replays the current demo's journal on top of the loaded snapshot and starts journaling
+        void Open();
+        void Close();
+
+        // Writes everything that is still queued and stops the worker, has to be called before the mod is unloaded
+        void Shutdown();
+
+        void RecordUpsert(const Types::Keyframe& keyframe);
+        void RecordRemoval(const Types::Keyframe& keyframe);
+
+        // Writes a snapshot of all keyframes and starts an empty journal
+        void Compact();
+
+        // the journal is compacted once it holds this many records
+        static constexpr std::size_t COMPACT_RECORD_COUNT = 4096;
+
+       private:
+        KeyframeJournal()
+        {
+        }
+
+        struct WriteTask
+        {
+            std::filesystem::path journalPath;
+            std::vector<char> records;
+
+            // compaction: replace the snapshot and start the journal over, records follow the new journal header
+            std::optional<std::pair<std::filesystem::path, KeyframeSerializer::Snapshot>> snapshot;
+        };
+
+        bool Replay();
+        void Append(std::span<const char> record);
+        void RunWorker();
+        void WriteTasks(const std::deque<WriteTask>& currentTasks);
+
+        bool isOpen = false;
+        bool needsSnapshot = false;
+        std::filesystem::path journalPath;
+        std::size_t recordCount = 0;
+        std::size_t journalSize = 0;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<WriteTask> tasks;
+        std::thread worker;
+        bool stopWorker = false;
+    };
+}  // namespace IWXMVM::Components
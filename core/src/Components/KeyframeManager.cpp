@@ -2,8 +2,10 @@
 #include "KeyframeManager.hpp"
 
 #include "Resources.hpp"
+#include "Configuration/PreferencesConfiguration.hpp"
 #include "Utilities/MathUtils.hpp"
 #include "KeyframeSerializer.hpp"
+#include "KeyframeJournal.hpp"
 #include "../UI/Components/KeyframeEditor.hpp"
 #include "../UI/UIManager.hpp"
 #include "Components/Playback.hpp"
@@ -109,6 +111,12 @@ namespace IWXMVM::Components
         Types::KeyframeValueType::FloatingPoint, 
         0.1f, 10
     );
+    Types::KeyframeableProperty playbackSpeed(
+        Types::KeyframeablePropertyType::PlaybackSpeed,
+        ICON_FA_GAUGE " Playback Speed",
+        Types::KeyframeValueType::FloatingPoint,
+        0, 2
+    );
 
     void KeyframeManager::HandleInput()
     {
@@ -149,11 +157,14 @@ namespace IWXMVM::Components
         InitializeProperty(dofNearStart);
         InitializeProperty(dofNearEnd);
         InitializeProperty(dofBias);
+        InitializeProperty(playbackSpeed);
 
         static bool justLoadedDemo = false;
 
         Events::RegisterListener(EventType::PostDemoLoad, [&]() { 
             
+            // clearing the previous demo's keyframes must not end up in the new demo's journal
+            KeyframeJournal::Get().Close();
             ClearKeyframes();
             
             if (Components::Playback::IsGameFrozen())
@@ -161,8 +172,8 @@ namespace IWXMVM::Components
                 Components::Playback::ToggleFrozenTick();
             }
             
-            actionHistory.clear();
-            undidActionHistory.clear();
+            actionHistory.Clear();
+            undidActionHistory.Clear();
             justLoadedDemo = true;
         });
 
@@ -172,6 +183,7 @@ namespace IWXMVM::Components
             if (IWXMVM::Mod::GetGameInterface()->GetGameState() == Types::GameState::InDemo && justLoadedDemo)
             {
                 Components::KeyframeSerializer::ReadRecent();
+                KeyframeJournal::Get().Open();
                 justLoadedDemo = false;
                 UI::UIManager::Get().GetUIComponent<UI::KeyframeEditor>(UI::Component::KeyframeEditor)->SetDefaultVerticalZoom();
             }
@@ -209,43 +221,74 @@ namespace IWXMVM::Components
 
     void KeyframeManager::SortAndSaveKeyframes(std::vector<Types::Keyframe>& keyframes)
     {
-        std::sort(keyframes.begin(), keyframes.end(), [](const auto& a, const auto& b) { return a.tick < b.tick; });
+        // saving happens through the KeyframeJournal, as edits are recorded. Keyframes on the same tick keep the
+        // order they were saved in, which the journal refers to them by.
+        KeyframeUtils::SortByTick(keyframes);
+
+        // in-place edits (e.g. dragging keyframes or loading them) are followed by this, so it is where they are
+        // noticed
+        for (const auto& [property, propertyKeyframes] : this->keyframes)
+        {
+            if (&propertyKeyframes == &keyframes)
+            {
+                MarkKeyframesChanged(property);
+                staleKeyframeIndices.insert(property.type);
+            }
+        }
+    }
 
-        Components::KeyframeSerializer::WriteRecent();
+    uint32_t KeyframeManager::GetKeyframesRevision(const Types::KeyframeableProperty& property) const
+    {
+        const auto it = keyframeRevisions.find(property.type);
+        return it != keyframeRevisions.end() ? it->second : 0;
     }
 
-    void KeyframeManager::UseMostRecentAction(std::deque<std::shared_ptr<KeyframeAction>>& actions,
-                                           const std::function<void(std::shared_ptr<KeyframeAction>)>& handleAction)
+    void KeyframeManager::MarkKeyframesChanged(const Types::KeyframeableProperty& property)
     {
-        if (!actions.empty() && !AreKeyframesBeingModified())
+        keyframeRevisions[property.type]++;
+    }
+
+    void KeyframeManager::UseMostRecentAction(ActionHistory& history,
+                                              const std::function<void(AnyKeyframeAction&)>& handleAction)
+    {
+        if (!history.actions.empty() && !AreKeyframesBeingModified())
         {
-            std::shared_ptr<KeyframeAction> action = actions.back();
-            actions.pop_back();
-            if (action)
-            {
-                handleAction(action);
-                Components::KeyframeManager::Get().SortAndSaveKeyframes(GetKeyframes(action->property));
-            }
+            AnyKeyframeAction action = history.Pop();
+            isCoalescingModifications = false;
+
+            handleAction(action);
+        }
+    }
+
+    void KeyframeManager::SortAffectedKeyframes(const AnyKeyframeAction& action)
+    {
+        // actions keep the index up to date themselves, unless the track has to be reordered
+        for (const auto propertyType : GetAffectedPropertyTypes(action))
+        {
+            if (KeyframeUtils::SortByTick(GetKeyframes(GetProperty(propertyType))))
+                staleKeyframeIndices.insert(propertyType);
         }
     }
 
     void KeyframeManager::Undo()
     {
-        UseMostRecentAction(actionHistory, [&](std::shared_ptr<KeyframeAction> action)
-            {
-                action->GetUndoAction()->DoAction();
-                AddAction_Internal(undidActionHistory, action);
-                nextActionWipeUndidHistory = true;
-            });
+        UseMostRecentAction(actionHistory, [&](AnyKeyframeAction& action) {
+            std::visit([](const auto& a) { a.UndoAction(); }, action);
+            SortAffectedKeyframes(action);
+            JournalAction(action, true);
+            undidActionHistory.Push(std::move(action), GetHistoryMemoryBudget());
+            nextActionWipeUndidHistory = true;
+        });
     }
 
     void KeyframeManager::Redo()
     {
-        UseMostRecentAction(undidActionHistory, [&](std::shared_ptr<KeyframeAction> action) 
-            {
-                action->DoAction();
-                AddAction_Internal(actionHistory, action);
-            });
+        UseMostRecentAction(undidActionHistory, [&](AnyKeyframeAction& action) {
+            std::visit([](const auto& a) { a.DoAction(); }, action);
+            SortAffectedKeyframes(action);
+            JournalAction(action, false);
+            actionHistory.Push(std::move(action), GetHistoryMemoryBudget());
+        });
     }
 
     void KeyframeManager::AddKeyframe(Types::KeyframeableProperty property, Types::Keyframe keyframeToAdd)
@@ -254,11 +297,11 @@ namespace IWXMVM::Components
     }
 
     void KeyframeManager::AddKeyframes(Types::KeyframeableProperty property,
-                                       const std::vector<Types::Keyframe> keyframesToAdd)
+                                       std::vector<Types::Keyframe> keyframesToAdd)
     {
-        std::shared_ptr<AddKeyframesAction> addAction = std::make_shared<AddKeyframesAction>(property, keyframesToAdd);
-        addAction->DoAction();
-        AddActionToHistory(addAction);
+        AddKeyframesAction addAction(property, std::move(keyframesToAdd));
+        addAction.DoAction();
+        AddActionToHistory(std::move(addAction));
     }
 
     void KeyframeManager::RemoveKeyframe(Types::KeyframeableProperty property,
@@ -277,10 +320,26 @@ namespace IWXMVM::Components
     {
         if (!keyframes[property].empty())
         {
-            std::shared_ptr<RemoveKeyframesAction> removeAction =
-                std::make_shared<RemoveKeyframesAction>(property, keyframesToRemove);
-            removeAction->DoAction();
-            AddActionToHistory(removeAction);
+            RemoveKeyframesAction removeAction(property, std::move(keyframesToRemove));
+            removeAction.DoAction();
+            AddActionToHistory(std::move(removeAction));
+        }
+    }
+
+    void KeyframeManager::RemoveKeyframes(
+        std::vector<std::pair<Types::KeyframeableProperty, std::vector<Types::Keyframe>>> keyframesToRemove)
+    {
+        RemoveKeyframesFromTracksAction removeAction;
+        for (auto& [property, keyframesOfProperty] : keyframesToRemove)
+        {
+            if (!keyframesOfProperty.empty())
+                removeAction.removals.emplace_back(property, std::move(keyframesOfProperty));
+        }
+
+        if (!removeAction.removals.empty())
+        {
+            removeAction.DoAction();
+            AddActionToHistory(std::move(removeAction));
         }
     }
 
@@ -291,16 +350,14 @@ namespace IWXMVM::Components
 
     void KeyframeManager::BeginModifyingKeyframeTick(Types::Keyframe& keyframeToModify)
     {
-        LOG_DEBUG("Begin Modifying Tick " + std::to_string(keyframeToModify.id));
         beginningTickMap[keyframeToModify.id] = keyframeToModify.tick;
     }
 
     void KeyframeManager::EndModifyingKeyframeTick(Types::KeyframeableProperty property,
                                                    Types::Keyframe& keyframeToModify)
     {
-        LOG_DEBUG("End Modifying Tick " + std::to_string(keyframeToModify.id));
-        std::shared_ptr<ModifyTickAction> modifyAction = std::make_shared<ModifyTickAction>(
-            property, beginningTickMap[keyframeToModify.id], keyframeToModify.tick, keyframeToModify.id);
+        ModifyAction modifyAction(property, keyframeToModify.id);
+        modifyAction.tick = std::make_pair(beginningTickMap[keyframeToModify.id], keyframeToModify.tick);
         AddActionToHistory(modifyAction);
         beginningTickMap.erase(keyframeToModify.id);
     }
@@ -312,16 +369,20 @@ namespace IWXMVM::Components
 
     void KeyframeManager::BeginModifyingKeyframeValue(Types::Keyframe& keyframeToModify)
     {
-        LOG_DEBUG("Begin Modifying Value " + std::to_string(keyframeToModify.id));
         beginningValueMap[keyframeToModify.id] = keyframeToModify.value;
     }
 
+    void KeyframeManager::BeginModifyingKeyframeValue(Types::Keyframe& keyframeToModify,
+                                                      Types::KeyframeValue originalValue)
+    {
+        beginningValueMap[keyframeToModify.id] = originalValue;
+    }
+
     void KeyframeManager::EndModifyingKeyframeValue(Types::KeyframeableProperty property,
                                                    Types::Keyframe& keyframeToModify)
     {
-        LOG_DEBUG("End Modifying Value " + std::to_string(keyframeToModify.id));
-        std::shared_ptr<ModifyValueAction> modifyAction = std::make_shared<ModifyValueAction>(
-            property, beginningValueMap[keyframeToModify.id], keyframeToModify.value, keyframeToModify.id);
+        ModifyAction modifyAction(property, keyframeToModify.id);
+        modifyAction.value = std::make_pair(beginningValueMap[keyframeToModify.id], keyframeToModify.value);
         AddActionToHistory(modifyAction);
         beginningValueMap.erase(keyframeToModify.id);
     }
@@ -329,33 +390,86 @@ namespace IWXMVM::Components
     void KeyframeManager::EndModifyingKeyframeTickAndValue(Types::KeyframeableProperty property,
                                                     Types::Keyframe& keyframeToModify)
     {
-        LOG_DEBUG("End Modifying Tick & Value " + std::to_string(keyframeToModify.id));
-        
-        std::shared_ptr<ModifyTickAndValueAction> modifyAction = std::make_shared<ModifyTickAndValueAction>(
-            property, beginningTickMap[keyframeToModify.id], keyframeToModify.tick,
-                                                       beginningValueMap[keyframeToModify.id],keyframeToModify.value, keyframeToModify.id);
+        ModifyAction modifyAction(property, keyframeToModify.id);
+        modifyAction.tick = std::make_pair(beginningTickMap[keyframeToModify.id], keyframeToModify.tick);
+        modifyAction.value = std::make_pair(beginningValueMap[keyframeToModify.id], keyframeToModify.value);
         AddActionToHistory(modifyAction);
         beginningTickMap.erase(keyframeToModify.id);
         beginningValueMap.erase(keyframeToModify.id);
     }
 
+    void KeyframeManager::SetKeyframeInterpolation(Types::KeyframeableProperty property,
+                                                   Types::Keyframe& keyframeToModify,
+                                                   Types::KeyframeInterpolation interpolation)
+    {
+        if (keyframeToModify.interpolation == interpolation)
+            return;
+
+        ModifyAction modifyAction(property, keyframeToModify.id);
+        modifyAction.interpolation = std::make_pair(keyframeToModify.interpolation, interpolation);
+        keyframeToModify.interpolation = interpolation;
+        MarkKeyframesChanged(property);
+        AddActionToHistory(modifyAction);
+    }
+
+    void KeyframeManager::SetKeyframeValues(Types::KeyframeableProperty property,
+                                            std::span<const Types::KeyframeValue> values)
+    {
+        auto& propertyKeyframes = keyframes[property];
+        assert(values.size() == propertyKeyframes.size());
+
+        ModifyValuesAction modifyAction(property);
+        modifyAction.changes.reserve(propertyKeyframes.size());
+        for (std::size_t i = 0; i < propertyKeyframes.size(); i++)
+        {
+            auto& keyframe = propertyKeyframes[i];
+            modifyAction.changes.push_back({keyframe.id, keyframe.value, values[i]});
+            keyframe.value = values[i];
+        }
+        MarkKeyframesChanged(property);
+
+        if (!modifyAction.changes.empty())
+            AddActionToHistory(std::move(modifyAction));
+    }
+
     Types::KeyframeValue KeyframeManager::Interpolate(const Types::KeyframeableProperty& property,
                                                       const std::vector<Types::Keyframe>& keyframes,
                                                       const float tick) const
     {
         if (keyframes.empty())
+        {
+            // the demo plays at its normal speed until a speed is keyframed
+            if (property.type == Types::KeyframeablePropertyType::PlaybackSpeed)
+                return Types::KeyframeValue(1.0f);
             return Types::KeyframeValue::GetDefaultValue(property.valueType);
+        }
 
         if (tick < keyframes.front().tick)
             return keyframes.front().value;
         if (tick > keyframes.back().tick)
             return keyframes.back().value;
 
-        // TODO: interpolation selection in the future
-        if (keyframes.size() < 4)
-            return LinearlyInterpolate(property.valueType, keyframes, tick);
+        if (&keyframes != &this->keyframes.at(property))
+        {
+            // not the property's own track (e.g. an edited copy), so there is no revision to cache it by
+            MathUtils::SegmentTable segmentTable;
+            segmentTable.Compile(property, keyframes);
+            return segmentTable.Evaluate(tick);
+        }
 
-        return CubicInterpolate(property.valueType, keyframes, tick);
+        return GetSegmentTable(property).Evaluate(tick);
+    }
+
+    const MathUtils::SegmentTable& KeyframeManager::GetSegmentTable(const Types::KeyframeableProperty& property) const
+    {
+        auto& compiledTrack = compiledTracks[property.type];
+        const auto revision = GetKeyframesRevision(property);
+        if (compiledTrack.revision != revision)
+        {
+            compiledTrack.segmentTable.Compile(property, keyframes.at(property));
+            compiledTrack.revision = revision;
+        }
+        return compiledTrack.segmentTable;
     }
 
     Types::KeyframeValue KeyframeManager::Interpolate(const Types::KeyframeableProperty& property,
@@ -376,178 +490,340 @@ namespace IWXMVM::Components
         return Interpolate(property, static_cast<float>(tick));
     }
 
-    Types::KeyframeValue KeyframeManager::CubicInterpolate(Types::KeyframeValueType valueType,
-                                                           const auto& keyframes,
-                                                           const float tick) const
+    std::size_t KeyframeManager::GetHistoryMemoryBudget() const
+    {
+        const auto budgetMegabytes = std::max(PreferencesConfiguration::Get().undoHistoryMemoryBudget, 1);
+        return static_cast<std::size_t>(budgetMegabytes) * 1024 * 1024;
+    }
+
+    void KeyframeManager::ActionHistory::Push(AnyKeyframeAction action, std::size_t memoryBudget)
+    {
+        memoryUsage += GetMemoryFootprint(action);
+        actions.push_back(std::move(action));
+
+        // always keep the most recent action, even if it alone exceeds the budget
+        while (memoryUsage > memoryBudget && actions.size() > 1)
+        {
+            memoryUsage -= GetMemoryFootprint(actions.front());
+            actions.pop_front();
+        }
+    }
+
+    KeyframeManager::AnyKeyframeAction KeyframeManager::ActionHistory::Pop()
+    {
+        AnyKeyframeAction action = std::move(actions.back());
+        actions.pop_back();
+        memoryUsage -= GetMemoryFootprint(action);
+        return action;
+    }
+
+    void KeyframeManager::ActionHistory::Clear()
     {
-        switch (valueType)
+        actions.clear();
+        memoryUsage = 0;
+    }
+
+    std::size_t KeyframeManager::ActionHistory::GetMemoryFootprint(const AnyKeyframeAction& action)
+    {
+        if (const auto manyKeyframesAction = std::get_if<AddKeyframesAction>(&action))
+            return sizeof(AnyKeyframeAction) + manyKeyframesAction->keyframes.capacity() * sizeof(Types::Keyframe);
+        if (const auto manyKeyframesAction = std::get_if<RemoveKeyframesAction>(&action))
+            return sizeof(AnyKeyframeAction) + manyKeyframesAction->keyframes.capacity() * sizeof(Types::Keyframe);
+        if (const auto modifyValuesAction = std::get_if<ModifyValuesAction>(&action))
+            return sizeof(AnyKeyframeAction) +
+                   modifyValuesAction->changes.capacity() * sizeof(ModifyValuesAction::ValueChange);
+        if (const auto groupAction = std::get_if<RemoveKeyframesFromTracksAction>(&action))
         {
-            case Types::KeyframeValueType::FloatingPoint:
-                return MathUtils::InterpolateCubicSpline(keyframes, 0, tick);
-            case Types::KeyframeValueType::Vector3:
-                return glm::vec3(
-                    MathUtils::InterpolateCubicSpline(keyframes, 0, tick),
-                    MathUtils::InterpolateCubicSpline(keyframes, 1, tick),
-                    MathUtils::InterpolateCubicSpline(keyframes, 2, tick)
-                );
-            case Types::KeyframeValueType::CameraData:
+            auto footprint =
+                sizeof(AnyKeyframeAction) + groupAction->removals.capacity() * sizeof(RemoveKeyframesAction);
+            for (const auto& removal : groupAction->removals)
+                footprint += removal.keyframes.capacity() * sizeof(Types::Keyframe);
+            return footprint;
+        }
+
+        return sizeof(AnyKeyframeAction);
+    }
+
+    void KeyframeManager::AddActionToHistory(AnyKeyframeAction action)
+    {
+        // callers may leave the track unsorted (e.g. after adding keyframes), but the journal may write it out
+        SortAffectedKeyframes(action);
+        JournalAction(action, false);
+
+        const auto now = std::chrono::steady_clock::now();
+        if (nextActionWipeUndidHistory)
+        {
+            undidActionHistory.Clear();
+            nextActionWipeUndidHistory = false;
+        }
+        else if (isCoalescingModifications && !actionHistory.actions.empty() &&
+                 now - lastModificationTime < MODIFICATION_COALESCING_INTERVAL)
+        {
+            // consecutive drags of the same keyframe end up as a single undo step
+            auto previousModifyAction = std::get_if<ModifyAction>(&actionHistory.actions.back());
+            auto modifyAction = std::get_if<ModifyAction>(&action);
+            if (previousModifyAction && modifyAction && previousModifyAction->TryCoalesce(*modifyAction))
             {
-                return Types::KeyframeValue(
-                    Types::CameraData(
-                        glm::vec3(
-                            MathUtils::InterpolateCubicSpline(keyframes, 0, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 1, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 2, tick)
-                        ),
-                        // TODO: do proper quaternion interpolation here
-                        glm::vec3(
-                            MathUtils::InterpolateCubicSpline(keyframes, 3, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 4, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 5, tick)
-                        ), 
-                        MathUtils::InterpolateCubicSpline(keyframes, 6, tick)
-                    )
-                );
+                lastModificationTime = now;
+                return;
             }
-            default:
-                return Types::KeyframeValue(0.0f);
         }
+
+        isCoalescingModifications = std::holds_alternative<ModifyAction>(action);
+        lastModificationTime = now;
+        actionHistory.Push(std::move(action), GetHistoryMemoryBudget());
+    }
+
+    std::vector<Types::KeyframeablePropertyType> KeyframeManager::GetAffectedPropertyTypes(
+        const AnyKeyframeAction& action)
+    {
+        std::vector<Types::KeyframeablePropertyType> propertyTypes;
+        std::visit(
+            [&](const auto& a) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(a)>, RemoveKeyframesFromTracksAction>)
+                {
+                    for (const auto& removal : a.removals)
+                        propertyTypes.push_back(removal.propertyType);
+                }
+                else
+                {
+                    propertyTypes.push_back(a.propertyType);
+                }
+            },
+            action);
+        return propertyTypes;
+    }
+
+    std::size_t KeyframeManager::GetAffectedKeyframeCount(const AnyKeyframeAction& action)
+    {
+        if (const auto modifyValuesAction = std::get_if<ModifyValuesAction>(&action))
+            return modifyValuesAction->changes.size();
+        if (const auto addAction = std::get_if<AddKeyframesAction>(&action))
+            return addAction->keyframes.size();
+        if (const auto removeAction = std::get_if<RemoveKeyframesAction>(&action))
+            return removeAction->keyframes.size();
+        if (const auto groupAction = std::get_if<RemoveKeyframesFromTracksAction>(&action))
+        {
+            return std::accumulate(groupAction->removals.begin(), groupAction->removals.end(), std::size_t{0},
+                                   [](std::size_t sum, const auto& removal) { return sum + removal.keyframes.size(); });
+        }
+        return 1;
     }
 
-    Types::KeyframeValue KeyframeManager::LinearlyInterpolate(Types::KeyframeValueType valueType, const auto& keyframes,
-                                                              const float tick) const
+    void KeyframeManager::JournalAction(const AnyKeyframeAction& action, bool undone)
     {
-        if (keyframes.size() == 1)
-            return keyframes.front().value;
+        auto& journal = KeyframeJournal::Get();
 
-        std::int32_t p0Idx = 0, p1Idx = 1;
-        for (std::size_t i = 0; i < keyframes.size() - 1; i++)
+        // bulk edits (e.g. imports) would be compacted right away, so write the snapshot without the records
+        if (GetAffectedKeyframeCount(action) >= KeyframeJournal::COMPACT_RECORD_COUNT)
         {
-            if (tick >= keyframes[i].tick && tick <= keyframes[i + 1].tick)
+            journal.Compact();
+            return;
+        }
+
+        if (const auto modifyAction = std::get_if<ModifyAction>(&action))
+        {
+            const auto& property = GetProperty(modifyAction->propertyType);
+            if (auto it = FindKeyframe(property, modifyAction->id); it != keyframes[property].end())
+                journal.RecordUpsert(*it);
+        }
+        else if (const auto modifyValuesAction = std::get_if<ModifyValuesAction>(&action))
+        {
+            const auto& property = GetProperty(modifyValuesAction->propertyType);
+            for (const auto& change : modifyValuesAction->changes)
+            {
+                if (auto it = FindKeyframe(property, change.id); it != keyframes[property].end())
+                    journal.RecordUpsert(*it);
+            }
+        }
+        else if (const auto addAction = std::get_if<AddKeyframesAction>(&action))
+        {
+            for (const auto& keyframe : addAction->keyframes)
+            {
+                if (undone)
+                    journal.RecordRemoval(keyframe);
+                else
+                    journal.RecordUpsert(keyframe);
+            }
+        }
+        else if (const auto removeAction = std::get_if<RemoveKeyframesAction>(&action))
+        {
+            for (const auto& keyframe : removeAction->keyframes)
             {
-                p0Idx = i;
-                p1Idx = i + 1;
-                break;
+                if (undone)
+                    journal.RecordUpsert(keyframe);
+                else
+                    journal.RecordRemoval(keyframe);
             }
         }
+        else if (const auto groupAction = std::get_if<RemoveKeyframesFromTracksAction>(&action))
+        {
+            for (const auto& removal : groupAction->removals)
+            {
+                for (const auto& keyframe : removal.keyframes)
+                {
+                    if (undone)
+                        journal.RecordUpsert(keyframe);
+                    else
+                        journal.RecordRemoval(keyframe);
+                }
+            }
+        }
+    }
 
-        assert(p0Idx != -1 || p1Idx != -1);
-        assert(keyframes[p0Idx].tick < keyframes[p1Idx].tick);
-        assert(p0Idx != p1Idx);
+    const Types::KeyframeableProperty& KeyframeManager::KeyframeAction::GetProperty() const
+    {
+        return KeyframeManager::Get().GetProperty(propertyType);
+    }
 
-        const auto& p0 = keyframes[p0Idx];
-        const auto& p1 = keyframes[p1Idx];
+    std::vector<Types::Keyframe>& KeyframeManager::KeyframeAction::GetKeyframes() const
+    {
+        return KeyframeManager::Get().GetKeyframes(GetProperty());
+    }
 
-        const float t = static_cast<float>(tick - p0.tick) / static_cast<float>(p1.tick - p0.tick);
-        switch (valueType)
+    std::vector<Types::Keyframe>::iterator KeyframeManager::KeyframeAction::GetKeyframe(int32_t id) const
+    {
+        return KeyframeManager::Get().FindKeyframe(GetProperty(), id);
+    }
+
+    std::vector<Types::Keyframe>::iterator KeyframeManager::FindKeyframe(const Types::KeyframeableProperty& property,
+                                                                         int32_t id)
+    {
+        auto& propertyKeyframes = keyframes[property];
+
+        // only the track itself knows when it was reordered, so rebuilding is deferred until the next lookup
+        if (staleKeyframeIndices.erase(property.type) > 0)
+            RebuildKeyframeIndex(property);
+
+        const auto& index = keyframeIndices[property.type];
+        const auto it = index.find(id);
+        if (it == index.end())
+            return propertyKeyframes.end();
+
+        if (it->second >= propertyKeyframes.size() || propertyKeyframes[it->second].id != id)
         {
-            case Types::KeyframeValueType::FloatingPoint:
-                return Types::KeyframeValue((1.0f - t) * p0.value.floatingPoint + t * p1.value.floatingPoint);
-            case Types::KeyframeValueType::Vector3:
-                return Types::KeyframeValue((1.0f - t) * p0.value.vector3 + t * p1.value.vector3);
-            case Types::KeyframeValueType::CameraData:
-                return Types::KeyframeValue(
-                    Types::CameraData((1.0f - t) * p0.value.cameraData.position + t * p1.value.cameraData.position,
-                                      (1.0f - t) * p0.value.cameraData.rotation + t * p1.value.cameraData.rotation,
-                                      (1.0f - t) * p0.value.cameraData.fov + t * p1.value.cameraData.fov));
-            default:
-                return Types::KeyframeValue(0.0f);
+            // the track was changed without SortAndSaveKeyframes
+            RebuildKeyframeIndex(property);
+            const auto rebuiltIt = index.find(id);
+            return rebuiltIt != index.end() ? propertyKeyframes.begin() + rebuiltIt->second : propertyKeyframes.end();
         }
-    }
 
+        return propertyKeyframes.begin() + it->second;
+    }
 
-    void KeyframeManager::AddAction_Internal(std::deque<std::shared_ptr<KeyframeAction>>& actionQue, std::shared_ptr<KeyframeAction> action) const
+    void KeyframeManager::RebuildKeyframeIndex(const Types::KeyframeableProperty& property)
     {
-        while (actionQue.size() >= MAX_ACTIONHISTORY)
-            actionQue.pop_front();
-        actionQue.push_back(action);
+        KeyframeUtils::BuildSlotIndex(keyframes[property], keyframeIndices[property.type]);
     }
 
-    void KeyframeManager::AddActionToHistory(std::shared_ptr<KeyframeAction> action)
+    void KeyframeManager::ModifyAction::DoAction() const
     {
-        if (nextActionWipeUndidHistory)
+        if (auto it = GetKeyframe(id); it != GetKeyframes().end())
         {
-            undidActionHistory.clear();
-            nextActionWipeUndidHistory = false;
+            if (tick.has_value())
+                it->tick = tick->second;
+            if (value.has_value())
+                it->value = value->second;
+            if (interpolation.has_value())
+                it->interpolation = interpolation->second;
+            KeyframeManager::Get().MarkKeyframesChanged(GetProperty());
         }
-        AddAction_Internal(actionHistory , action);
     }
 
-    void KeyframeManager::ModifyTickAction::DoAction() const
+    void KeyframeManager::ModifyAction::UndoAction() const
     {
         if (auto it = GetKeyframe(id); it != GetKeyframes().end())
-            it->tick = newTick;
+        {
+            if (tick.has_value())
+                it->tick = tick->first;
+            if (value.has_value())
+                it->value = value->first;
+            if (interpolation.has_value())
+                it->interpolation = interpolation->first;
+            KeyframeManager::Get().MarkKeyframesChanged(GetProperty());
+        }
     }
 
-    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::ModifyTickAction::GetUndoAction() const
+    void KeyframeManager::ModifyValuesAction::DoAction() const
     {
-        return std::make_unique<ModifyTickAction>(property,newTick,oldTick,id);
+        for (const auto& change : changes)
+        {
+            if (auto it = GetKeyframe(change.id); it != GetKeyframes().end())
+                it->value = change.newValue;
+        }
+        KeyframeManager::Get().MarkKeyframesChanged(GetProperty());
     }
 
-    std::vector<Types::Keyframe>::iterator KeyframeManager::KeyframeAction::GetKeyframe(uint32_t id) const
+    void KeyframeManager::ModifyValuesAction::UndoAction() const
     {
-        auto& keyframes = GetKeyframes();
-        auto it = std::find_if(keyframes.begin(), keyframes.end(), [&](const Types::Keyframe& kf) { return kf.id == id; });
-        return it;
+        for (const auto& change : changes)
+        {
+            if (auto it = GetKeyframe(change.id); it != GetKeyframes().end())
+                it->value = change.oldValue;
+        }
+        KeyframeManager::Get().MarkKeyframesChanged(GetProperty());
     }
 
-    std::vector<Types::Keyframe>& KeyframeManager::KeyframeAction::GetKeyframes() const
+    bool KeyframeManager::ModifyAction::TryCoalesce(const ModifyAction& next)
     {
-        return KeyframeManager::Get().GetKeyframes(property);
+        if (next.propertyType != propertyType || next.id != id)
+            return false;
+
+        // keep our original state and take over the most recent one
+        if (next.tick.has_value())
+            tick = std::make_pair(tick.has_value() ? tick->first : next.tick->first, next.tick->second);
+        if (next.value.has_value())
+            value = std::make_pair(value.has_value() ? value->first : next.value->first, next.value->second);
+        if (next.interpolation.has_value())
+            interpolation = std::make_pair(interpolation.has_value() ? interpolation->first : next.interpolation->first,
+                                           next.interpolation->second);
+
+        return true;
     }
 
-    void KeyframeManager::ModifyValueAction::DoAction() const
+    void KeyframeManager::ManyKeyframesAction::AddToTrack() const
     {
-        if (auto it = GetKeyframe(id); it != GetKeyframes().end())
-            it->value = newValue;
+        KeyframeUtils::AppendKeyframes(GetKeyframes(), keyframes, KeyframeManager::Get().keyframeIndices[propertyType]);
+        KeyframeManager::Get().MarkKeyframesChanged(GetProperty());
     }
 
-    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::ModifyValueAction::GetUndoAction() const
+    void KeyframeManager::ManyKeyframesAction::RemoveFromTrack() const
     {
-        return std::make_unique<ModifyValueAction>(property, newValue, oldValue, id);
+        KeyframeUtils::EraseKeyframes(GetKeyframes(), keyframes);
+
+        KeyframeManager::Get().staleKeyframeIndices.insert(propertyType);
+        KeyframeManager::Get().MarkKeyframesChanged(GetProperty());
     }
 
-    void KeyframeManager::ModifyTickAndValueAction::DoAction() const
+    void KeyframeManager::RemoveKeyframesAction::DoAction() const
     {
-        if (auto it = GetKeyframe(id); it != GetKeyframes().end())
-        {
-            it->tick = newTick;
-            it->value = newValue;
-        }
+        RemoveFromTrack();
     }
 
-    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::ModifyTickAndValueAction::GetUndoAction() const
+    void KeyframeManager::RemoveKeyframesAction::UndoAction() const
     {
-        return std::make_unique<ModifyTickAndValueAction>(property,newTick,oldTick,newValue,oldValue,id);
+        AddToTrack();
     }
 
-    void KeyframeManager::RemoveKeyframesAction::DoAction() const
+    void KeyframeManager::RemoveKeyframesFromTracksAction::DoAction() const
     {
-        for (auto& keyframe : keyframes)
-        {
-            if (auto it = GetKeyframe(keyframe.id); it != GetKeyframes().end())
-            {
-                GetKeyframes().erase(it);
-            }
-        }
+        for (const auto& removal : removals)
+            removal.DoAction();
     }
 
-    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::RemoveKeyframesAction::GetUndoAction() const
+    void KeyframeManager::RemoveKeyframesFromTracksAction::UndoAction() const
     {
-        return std::make_unique<AddKeyframesAction>(property,keyframes);
+        for (auto it = removals.rbegin(); it != removals.rend(); ++it)
+            it->UndoAction();
     }
 
     void KeyframeManager::AddKeyframesAction::DoAction() const
     {
-        for (auto& keyframe : keyframes)
-        {
-            GetKeyframes().emplace_back(keyframe);
-        }
+        AddToTrack();
     }
 
-    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::AddKeyframesAction::GetUndoAction() const
+    void KeyframeManager::AddKeyframesAction::UndoAction() const
     {
-        return std::make_unique<RemoveKeyframesAction>(property, keyframes);
+        RemoveFromTrack();
     }
-
-}  // namespace IWXMVM::Components
+}  // namespace IWXMVM::Components
\ No newline at end of file
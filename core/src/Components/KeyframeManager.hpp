@@ -1,6 +1,8 @@
 #pragma once
 #include "Types/Keyframe.hpp"
 #include "Types/KeyframeableProperty.hpp"
+#include "Utilities/KeyframeUtils.hpp"
+#include "Utilities/SegmentTable.hpp"
 
 namespace IWXMVM::Components
 {
@@ -34,11 +36,14 @@ namespace IWXMVM::Components
         void Redo();
 
         void AddKeyframe(Types::KeyframeableProperty property, Types::Keyframe keyframeToAdd);
-        void AddKeyframes(Types::KeyframeableProperty property, const std::vector<Types::Keyframe> keyframesToAdd);
+        void AddKeyframes(Types::KeyframeableProperty property, std::vector<Types::Keyframe> keyframesToAdd);
 
         void RemoveKeyframe(Types::KeyframeableProperty property, std::vector<Types::Keyframe>::iterator it);
         void RemoveKeyframe(Types::KeyframeableProperty property, size_t indexToRemove);
         void RemoveKeyframes(Types::KeyframeableProperty property, std::vector<Types::Keyframe> keyframesToRemove);
+        // Removes keyframes from several tracks at once, as a single undo step
+        void RemoveKeyframes(
+            std::vector<std::pair<Types::KeyframeableProperty, std::vector<Types::Keyframe>>> keyframesToRemove);
 
         bool IsKeyframeTickBeingModified(Types::Keyframe& keyframe);
 
@@ -48,15 +53,35 @@ namespace IWXMVM::Components
         bool IsKeyframeValueBeingModified(Types::Keyframe& keyframe);
 
         void BeginModifyingKeyframeValue(Types::Keyframe& keyframeToModify);
+        // For edits that are only noticed once they were applied (e.g. by the gizmos)
+        void BeginModifyingKeyframeValue(Types::Keyframe& keyframeToModify, Types::KeyframeValue originalValue);
         void EndModifyingKeyframeValue(Types::KeyframeableProperty property, Types::Keyframe& keyframeToModify);
 
         void EndModifyingKeyframeTickAndValue(Types::KeyframeableProperty property, Types::Keyframe& keyframeToModify);
 
+        void SetKeyframeInterpolation(Types::KeyframeableProperty property, Types::Keyframe& keyframeToModify,
+                                      Types::KeyframeInterpolation interpolation);
+
+        // Replaces the values of all keyframes of the property, given in the order of its keyframes, as a single
+        // undo step
+        void SetKeyframeValues(Types::KeyframeableProperty property, std::span<const Types::KeyframeValue> values);
+
         void ClearKeyframes();
         void ClearKeyframes(Types::KeyframeableProperty property);
 
         bool AreKeyframesBeingModified();
 
+        // The next modification starts a new undo step, even if it modifies the same keyframe as the previous one
+        void BreakModificationCoalescing()
+        {
+            isCoalescingModifications = false;
+        }
+
+        // Increased whenever keyframes of the property change, so anything derived from them knows when to rebuild.
+        // Actions and SortAndSaveKeyframes take care of this; other in-place edits have to call MarkKeyframesChanged.
+        uint32_t GetKeyframesRevision(const Types::KeyframeableProperty& property) const;
+        void MarkKeyframesChanged(const Types::KeyframeableProperty& property);
+
         Types::KeyframeValue Interpolate(const Types::KeyframeableProperty& property,
                                          const std::vector<Types::Keyframe>& keyframes, const float tick) const;
         Types::KeyframeValue Interpolate(const Types::KeyframeableProperty& property,
@@ -66,115 +91,156 @@ namespace IWXMVM::Components
 
         const Types::KeyframeableProperty& GetProperty(const Types::KeyframeablePropertyType property) const;
 
+        // The property's keyframes compiled for evaluation, only recompiled after they changed. Must not be empty.
+        const MathUtils::SegmentTable& GetSegmentTable(const Types::KeyframeableProperty& property) const;
+
 
         void SortAndSaveKeyframes(std::vector<Types::Keyframe>& keyframes);
 
        private:
         KeyframeManager(){}
 
-        Types::KeyframeValue CubicInterpolate(Types::KeyframeValueType valueType, const auto& keyframes,
-                                              const float tick) const;
-        Types::KeyframeValue LinearlyInterpolate(Types::KeyframeValueType valueType, const auto& keyframes,
-                                                 const float tick) const;
-
         struct KeyframeAction
         {
-            Types::KeyframeableProperty property;
-            KeyframeAction(const Types::KeyframeableProperty& prop) : property(prop){}
-
-            virtual void DoAction() const = 0;
-            virtual std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const = 0;
+            Types::KeyframeablePropertyType propertyType;
+            KeyframeAction(const Types::KeyframeableProperty& prop) : propertyType(prop.type){}
 
            protected:
+            const Types::KeyframeableProperty& GetProperty() const;
             std::vector<Types::Keyframe>& GetKeyframes() const;
-            std::vector<Types::Keyframe>::iterator GetKeyframe(uint32_t id) const;
+            std::vector<Types::Keyframe>::iterator GetKeyframe(int32_t id) const;
         };
 
-        struct ModifyAction : KeyframeManager::KeyframeAction
-        {
-            uint32_t id;
-            ModifyAction(const Types::KeyframeableProperty& prop, uint32_t keyframeID)
-                : KeyframeAction(prop), id(keyframeID){}
-        };
+        // Maps keyframe ids to their position in the property's keyframe vector, so actions can find a keyframe
+        // without walking the whole track. Removals and reordering mark the index as stale, and it is only rebuilt
+        // on the next lookup, so looking up ids that are not in the track stays cheap.
+        std::vector<Types::Keyframe>::iterator FindKeyframe(const Types::KeyframeableProperty& property, int32_t id);
+        void RebuildKeyframeIndex(const Types::KeyframeableProperty& property);
 
-        struct ModifyTickAndValueAction : ModifyAction
+        // Covers tick, value and interpolation edits in any combination; whichever part was not modified is left empty
+        struct ModifyAction : KeyframeAction
         {
-            uint32_t oldTick;
-            uint32_t newTick;
-            Types::KeyframeValue oldValue;
-            Types::KeyframeValue newValue;
-
-            ModifyTickAndValueAction(const Types::KeyframeableProperty& prop, uint32_t oTick, uint32_t nTick,
-                                     Types::KeyframeValue oValue, Types::KeyframeValue nValue, uint32_t keyframeID)
-                : ModifyAction(prop, keyframeID), oldTick(oTick), newTick(nTick), oldValue(oValue), newValue(nValue){}
-
-            void DoAction() const final;
-            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
-        };
+            int32_t id;
+            std::optional<std::pair<uint32_t, uint32_t>> tick;  // old, new
+            std::optional<std::pair<Types::KeyframeValue, Types::KeyframeValue>> value;  // old, new
+            std::optional<std::pair<Types::KeyframeInterpolation, Types::KeyframeInterpolation>> interpolation;
 
-        struct ModifyTickAction : ModifyAction
-        {
-            uint32_t oldTick;
-            uint32_t newTick;
+            ModifyAction(const Types::KeyframeableProperty& prop, int32_t keyframeID)
+                : KeyframeAction(prop), id(keyframeID){}
 
-            ModifyTickAction(const Types::KeyframeableProperty& prop, uint32_t oTick, uint32_t nTick,
-                             uint32_t keyframeID)
-                : ModifyAction(prop, keyframeID), oldTick(oTick), newTick(nTick){}
+            void DoAction() const;
+            void UndoAction() const;
 
-            void DoAction() const final;
-            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
+            // Merges a directly following modification of the same keyframe into this action
+            bool TryCoalesce(const ModifyAction& next);
         };
 
-        struct ModifyValueAction : ModifyAction
+        // Value edits of many keyframes of the same property at once
+        struct ModifyValuesAction : KeyframeAction
         {
-            Types::KeyframeValue oldValue;
-            Types::KeyframeValue newValue;
-
-            ModifyValueAction(const Types::KeyframeableProperty& prop, Types::KeyframeValue oValue,
-                              Types::KeyframeValue nValue, uint32_t keyframeID)
-                : ModifyAction(prop, keyframeID), oldValue(oValue), newValue(nValue){}
-
-            void DoAction() const final;
-            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
+            struct ValueChange
+            {
+                int32_t id;
+                Types::KeyframeValue oldValue;
+                Types::KeyframeValue newValue;
+            };
+            std::vector<ValueChange> changes;
+
+            ModifyValuesAction(const Types::KeyframeableProperty& prop) : KeyframeAction(prop){}
+
+            void DoAction() const;
+            void UndoAction() const;
         };
 
         struct ManyKeyframesAction : KeyframeAction
         {
             std::vector<Types::Keyframe> keyframes;
             ManyKeyframesAction(const Types::KeyframeableProperty& prop, std::vector<Types::Keyframe> keyframes)
-                : KeyframeAction(prop), keyframes(keyframes){}
+                : KeyframeAction(prop), keyframes(std::move(keyframes)){}
+
+           protected:
+            void AddToTrack() const;
+            void RemoveFromTrack() const;
         };
 
         struct RemoveKeyframesAction : ManyKeyframesAction
         {
             RemoveKeyframesAction(const Types::KeyframeableProperty& prop, std::vector<Types::Keyframe> keyframes)
-                : ManyKeyframesAction(prop, keyframes){}
+                : ManyKeyframesAction(prop, std::move(keyframes)){}
 
-            virtual void DoAction() const final;
-            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
+            void DoAction() const;
+            void UndoAction() const;
         };
 
         struct AddKeyframesAction : ManyKeyframesAction
         {
             AddKeyframesAction(const Types::KeyframeableProperty& prop, std::vector<Types::Keyframe> keyframes)
-                : ManyKeyframesAction(prop, keyframes){}
+                : ManyKeyframesAction(prop, std::move(keyframes)){}
+
+            void DoAction() const;
+            void UndoAction() const;
+        };
+
+        struct RemoveKeyframesFromTracksAction
+        {
+            std::vector<RemoveKeyframesAction> removals;
 
-            virtual void DoAction() const final;
-            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
+            void DoAction() const;
+            void UndoAction() const;
         };
 
-        void UseMostRecentAction(std::deque<std::shared_ptr<KeyframeAction>>& actions,
-                                 const std::function<void(std::shared_ptr<KeyframeAction>)>& handleAction);
+        using AnyKeyframeAction = std::variant<ModifyAction, ModifyValuesAction, AddKeyframesAction,
+                                               RemoveKeyframesAction, RemoveKeyframesFromTracksAction>;
+
+        static std::vector<Types::KeyframeablePropertyType> GetAffectedPropertyTypes(const AnyKeyframeAction& action);
+        static std::size_t GetAffectedKeyframeCount(const AnyKeyframeAction& action);
 
-        void AddActionToHistory(std::shared_ptr<KeyframeAction> action);
-        void AddAction_Internal(std::deque<std::shared_ptr<KeyframeAction>>& actionQue, std::shared_ptr<KeyframeAction> action) const;
+        // Undo/redo history bounded by the approximate memory its actions occupy rather than by a fixed count.
+        // Actions are stored by value in the deque's chunked storage instead of being heap allocated one by one.
+        struct ActionHistory
+        {
+            std::deque<AnyKeyframeAction> actions;
+            std::size_t memoryUsage = 0;
+
+            void Push(AnyKeyframeAction action, std::size_t memoryBudget);
+            AnyKeyframeAction Pop();
+            void Clear();
+
+            static std::size_t GetMemoryFootprint(const AnyKeyframeAction& action);
+        };
+
+        std::size_t GetHistoryMemoryBudget() const;
+
+        void UseMostRecentAction(ActionHistory& history, const std::function<void(AnyKeyframeAction&)>& handleAction);
+
+        // Tracks are only journaled sorted, since the journal may write them out as a snapshot
+        void SortAffectedKeyframes(const AnyKeyframeAction& action);
+
+        void AddActionToHistory(AnyKeyframeAction action);
+
+        // Records the effect of an action that was just applied (or undone) in the KeyframeJournal
+        void JournalAction(const AnyKeyframeAction& action, bool undone);
 
         std::map<Types::KeyframeableProperty, std::vector<Types::Keyframe>> keyframes;
+        std::unordered_map<Types::KeyframeablePropertyType, KeyframeUtils::SlotIndex> keyframeIndices;
+        std::unordered_set<Types::KeyframeablePropertyType> staleKeyframeIndices;
+        std::unordered_map<Types::KeyframeablePropertyType, uint32_t> keyframeRevisions;
+
+        // compiled lazily on the first evaluation after a track changed
+        struct CompiledTrack
+        {
+            MathUtils::SegmentTable segmentTable;
+            std::optional<uint32_t> revision;
+        };
+        mutable std::unordered_map<Types::KeyframeablePropertyType, CompiledTrack> compiledTracks;
         std::unordered_map<uint32_t, uint32_t> beginningTickMap;
         std::unordered_map<uint32_t, Types::KeyframeValue> beginningValueMap;
-        const size_t MAX_ACTIONHISTORY = 25;
         bool nextActionWipeUndidHistory = false;
-        std::deque<std::shared_ptr<KeyframeAction>> undidActionHistory;
-        std::deque<std::shared_ptr<KeyframeAction>> actionHistory;
+        // modifications of the same keyframe are coalesced until a pause, undoing, redoing or selecting another node
+        static constexpr auto MODIFICATION_COALESCING_INTERVAL = std::chrono::seconds(2);
+        bool isCoalescingModifications = false;
+        std::chrono::steady_clock::time_point lastModificationTime;
+        ActionHistory undidActionHistory;
+        ActionHistory actionHistory;
     };
 }  // namespace IWXMVM::Components
\ No newline at end of file
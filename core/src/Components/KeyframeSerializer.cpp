@@ -4,6 +4,7 @@
 #include "nlohmann/json.hpp"
 
 #include "Utilities/PathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 #include "KeyframeManager.hpp"
 #include "Mod.hpp"
 #include "Playback.hpp"
@@ -20,93 +21,494 @@ namespace IWXMVM::Components
     constexpr std::string_view NODE_VALUES = "values";
     constexpr std::string_view NODE_VALUE = "value";
     constexpr std::string_view NODE_KEYFRAMES = "keyframes";
+    constexpr std::string_view NODE_INTERPOLATION = "interpolation";
+    constexpr std::string_view NODE_MODE = "mode";
+    constexpr std::string_view NODE_IN_TANGENTS = "inTangents";
+    constexpr std::string_view NODE_OUT_TANGENTS = "outTangents";
+    constexpr std::string_view NODE_TENSION = "tension";
+    constexpr std::string_view NODE_CONTINUITY = "continuity";
+    constexpr std::string_view NODE_BIAS = "bias";
 
-    void KeyframeSerializer::Write(std::filesystem::path path)
+    // The JSON format is written and read as a stream, without building a json DOM for the whole file
+    constexpr std::size_t JSON_WRITE_BUFFER_SIZE = 1 << 16;
+
+    std::string EscapeJsonString(std::string_view string)
+    {
+        std::string escaped = "\"";
+        escaped.reserve(string.size() + 2);
+        for (const char c : string)
+        {
+            switch (c)
+            {
+                case '"':
+                    escaped += "\\\"";
+                    break;
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        escaped += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+                    else
+                        escaped += c;
+                    break;
+            }
+        }
+        escaped += '"';
+        return escaped;
+    }
+
+    template <typename OutputIt>
+    void WriteJsonFloatArray(OutputIt out, std::span<const float> values)
     {
-        using json = nlohmann::json;
+        std::format_to(out, "[");
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            // JSON has no representation for nan and infinity
+            const auto value = std::isfinite(values[i]) ? values[i] : 0.0f;
+            std::format_to(out, "{}{}", i == 0 ? "" : ", ", value);
+        }
+        std::format_to(out, "]");
+    }
+
+    template <typename OutputIt>
+    void WriteJsonInterpolation(OutputIt out, const Types::KeyframeInterpolation& interpolation, int32_t valueCount,
+                                std::string_view indent)
+    {
+        std::format_to(out, "{{\n{}    \"{}\": \"{}\"", indent, NODE_MODE, magic_enum::enum_name(interpolation.mode));
+
+        const auto& parameters = interpolation.GetParameters();
+        switch (interpolation.mode)
+        {
+            case Types::KeyframeInterpolationMode::Bezier:
+                std::format_to(out, ",\n{}    \"{}\": ", indent, NODE_IN_TANGENTS);
+                WriteJsonFloatArray(out, std::span(parameters.inTangents).first(valueCount));
+                std::format_to(out, ",\n{}    \"{}\": ", indent, NODE_OUT_TANGENTS);
+                WriteJsonFloatArray(out, std::span(parameters.outTangents).first(valueCount));
+                break;
+            case Types::KeyframeInterpolationMode::TCB:
+                std::format_to(out, ",\n{0}    \"{1}\": {2},\n{0}    \"{3}\": {4},\n{0}    \"{5}\": {6}", indent,
+                               NODE_TENSION, parameters.tension, NODE_CONTINUITY, parameters.continuity, NODE_BIAS,
+                               parameters.bias);
+                break;
+            default:
+                break;
+        }
 
+        std::format_to(out, "\n{}}}", indent);
+    }
+
+    void WriteJson(const std::filesystem::path& path)
+    {
         if (!std::filesystem::exists(path.parent_path()))
         {
             std::filesystem::create_directories(path.parent_path());
         }
 
-        json rootNode;
-        rootNode[NODE_GAME_NAME] = magic_enum::enum_name(Mod::GetGameInterface()->GetGame());
-        rootNode[NODE_DEMO_NAME] = Mod::GetGameInterface()->GetDemoInfo().name;
+        std::vector<char> buffer(JSON_WRITE_BUFFER_SIZE);
+        std::ofstream keyframeFile(path);
+        if (!keyframeFile.is_open())
+        {
+            LOG_ERROR("Failed to write keyframe file at {}", path.string());
+            return;
+        }
+
+        // only after opening, MSVC's filebuf ignores buffers that are set before there is a file
+        keyframeFile.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+
+        auto out = std::ostreambuf_iterator<char>(keyframeFile);
+
+        std::format_to(out, "{{\n    \"{}\": {},\n", NODE_DEMO_NAME,
+                       EscapeJsonString(Mod::GetGameInterface()->GetDemoInfo().name));
         if (Components::Playback::IsGameFrozen())
         {
-            rootNode[NODE_FROZEN_TICK] = Components::Playback::GetFrozenTick().value();
+            std::format_to(out, "    \"{}\": {},\n", NODE_FROZEN_TICK, Components::Playback::GetFrozenTick().value());
         }
-        
-        json properties = json::array();
+        std::format_to(out, "    \"{}\": \"{}\",\n", NODE_GAME_NAME,
+                       magic_enum::enum_name(Mod::GetGameInterface()->GetGame()));
+        std::format_to(out, "    \"{}\": [", NODE_PROPERTIES);
 
+        bool firstProperty = true;
         for (auto& [p, ks] : KeyframeManager::Get().GetKeyframes())
         {
-            json propertyObject;
-            propertyObject[NODE_PROPERTY] = magic_enum::enum_name(p.type);
+            std::format_to(out, "{}\n        {{\n            \"{}\": [", firstProperty ? "" : ",", NODE_KEYFRAMES);
+            firstProperty = false;
 
-            json keyframeList = json::array();
-            for (auto& k : ks)
+            std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT> values{};
+            for (std::size_t i = 0; i < ks.size(); i++)
             {
-                json keyframeObject;
-                keyframeObject[NODE_TICK] = k.tick;
+                const auto& k = ks[i];
 
-                json keyframeValueObject;
-                keyframeValueObject[NODE_TYPE] = magic_enum::enum_name(p.valueType);
+                std::format_to(out, "{}\n                {{\n                    \"{}\": ", i == 0 ? "" : ",",
+                               NODE_INTERPOLATION);
+                WriteJsonInterpolation(out, k.interpolation, p.GetValueCount(), "                    ");
 
-                json keyframeValuesArray;
-                keyframeValuesArray = json::array();
-                for (int i = 0; i < p.GetValueCount(); i++)
+                for (int32_t j = 0; j < p.GetValueCount(); j++)
                 {
-                    keyframeValuesArray.push_back(k.value.GetByIndex(i));
+                    values[j] = k.value.GetByIndex(j);
                 }
-                keyframeValueObject[NODE_VALUES] = keyframeValuesArray;
 
-                keyframeObject[NODE_VALUE] = keyframeValueObject;
-                keyframeList.push_back(keyframeObject);
+                std::format_to(out, ",\n                    \"{}\": {},\n", NODE_TICK, k.tick);
+                std::format_to(out, "                    \"{}\": {{\n", NODE_VALUE);
+                std::format_to(out, "                        \"{}\": \"{}\",\n", NODE_TYPE,
+                               magic_enum::enum_name(p.valueType));
+                std::format_to(out, "                        \"{}\": ", NODE_VALUES);
+                WriteJsonFloatArray(out, std::span(values).first(p.GetValueCount()));
+                std::format_to(out, "\n                    }}\n                }}");
             }
 
-            propertyObject[NODE_KEYFRAMES] = keyframeList;
-            properties.push_back(propertyObject);
+            std::format_to(out, "{}],\n            \"{}\": \"{}\"\n        }}", ks.empty() ? "" : "\n            ",
+                           NODE_PROPERTY, magic_enum::enum_name(p.type));
         }
 
-        rootNode[NODE_PROPERTIES] = properties;
-
-        std::ofstream keyframeFile(path);
-        keyframeFile << rootNode.dump(4);
+        std::format_to(out, "{}]\n}}\n", firstProperty ? "" : "\n    ");
         keyframeFile.close();
     }
 
-    Types::KeyframeValue ReadValueOfType(const Types::KeyframeValueType valueType, const nlohmann::json& values)
-    {
-        switch (valueType)
-        {
-            case Types::KeyframeValueType::FloatingPoint:
-                return Types::KeyframeValue(values[0].get<float>());
-            case Types::KeyframeValueType::Vector3:
-                return Types::KeyframeValue(
-                    glm::vec3(
-                        values[0].get<float>(),
-                        values[1].get<float>(), 
-                        values[2].get<float>()
-                    )
-                );
-            case Types::KeyframeValueType::CameraData:
-                auto cameraData = Types::CameraData();
-                cameraData.position = glm::vec3(values[0].get<float>(), values[1].get<float>(), values[2].get<float>());
-                cameraData.rotation = glm::vec3(values[3].get<float>(), values[4].get<float>(), values[5].get<float>());
-                cameraData.fov = values[6].get<float>();
-                return Types::KeyframeValue(cameraData);
-            default:
-                LOG_ERROR("Value type {} is unhandled", magic_enum::enum_name(valueType));
-                throw std::runtime_error("Encountered unhandled value type");
-        }
+    // Loaded keyframes are added on top of existing ones, the vector is taken over as is when the track is empty
+    void AddLoadedKeyframes(const Types::KeyframeableProperty& property, std::vector<Types::Keyframe>&& loadedKeyframes)
+    {
+        auto& keyframes = Components::KeyframeManager::Get().GetKeyframes(property);
+        if (keyframes.empty())
+            keyframes = std::move(loadedKeyframes);
+        else
+            keyframes.insert(keyframes.end(), std::make_move_iterator(loadedKeyframes.begin()),
+                             std::make_move_iterator(loadedKeyframes.end()));
+        Components::KeyframeManager::Get().SortAndSaveKeyframes(keyframes);
     }
 
-    void KeyframeSerializer::Read(std::filesystem::path path, bool requireDemoMatch)
+    // Fills keyframe tracks directly from the parser's events. Keys within an object may come in any order (they are
+    // sorted alphabetically when written), so keyframes are built in place against a placeholder property and only
+    // attached to their property once the property object is complete.
+    class KeyframeJsonHandler : public nlohmann::json_sax<nlohmann::json>
     {
-        using json = nlohmann::json;
+       public:
+        struct Track
+        {
+            const Types::KeyframeableProperty* property;
+            std::vector<Types::Keyframe> keyframes;
+        };
+
+        std::string gameName;
+        std::string demoName;
+        std::optional<uint32_t> frozenTick;
+        std::vector<Track> tracks;
+
+        bool skippedDemo = false;
+
+        KeyframeJsonHandler(std::string_view currentDemoName, bool requireDemoMatch)
+            : currentDemoName(currentDemoName), requireDemoMatch(requireDemoMatch)
+        {
+        }
+
+        bool null() override
+        {
+            // frozenTick is null when the game was not frozen, anything else is treated as zero
+            if (IsInArray())
+                Number(0.0);
+            return true;
+        }
+
+        bool boolean(bool) override
+        {
+            NextElement();
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) override
+        {
+            Number(static_cast<double>(value));
+            return true;
+        }
+
+        bool number_unsigned(number_unsigned_t value) override
+        {
+            Number(static_cast<double>(value));
+            return true;
+        }
+
+        bool number_float(number_float_t value, const string_t&) override
+        {
+            Number(value);
+            return true;
+        }
+
+        bool string(string_t& value) override
+        {
+            switch (GetLocation())
+            {
+                case Location::Root:
+                    if (currentKey == NODE_GAME_NAME)
+                    {
+                        gameName = value;
+                    }
+                    else if (currentKey == NODE_DEMO_NAME)
+                    {
+                        demoName = value;
+                        if (requireDemoMatch && demoName != currentDemoName)
+                        {
+                            // no need to parse the rest of the file
+                            skippedDemo = true;
+                            return false;
+                        }
+                    }
+                    break;
+                case Location::Property:
+                    if (currentKey == NODE_PROPERTY)
+                    {
+                        auto propertyType = magic_enum::enum_cast<Types::KeyframeablePropertyType>(value);
+                        if (!propertyType.has_value())
+                        {
+                            LOG_ERROR("Unknown property \"{0}\"", value);
+                            throw std::runtime_error("Unknown property encountered");
+                        }
+                        property = &Components::KeyframeManager::Get().GetProperty(propertyType.value());
+                    }
+                    break;
+                case Location::Value:
+                    if (currentKey == NODE_TYPE && !magic_enum::enum_cast<Types::KeyframeValueType>(value).has_value())
+                    {
+                        LOG_ERROR("Unknown value type \"{0}\"", value);
+                        throw std::runtime_error("Unknown value type encountered");
+                    }
+                    break;
+                case Location::Interpolation:
+                    if (currentKey == NODE_MODE)
+                    {
+                        auto mode = magic_enum::enum_cast<Types::KeyframeInterpolationMode>(value);
+                        if (!mode.has_value())
+                        {
+                            LOG_ERROR("Unknown interpolation mode \"{0}\"", value);
+                            throw std::runtime_error("Unknown interpolation mode encountered");
+                        }
+                        keyframes.back().interpolation.mode = mode.value();
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            NextElement();
+            return true;
+        }
+
+        bool binary(binary_t&) override
+        {
+            NextElement();
+            return true;
+        }
+
+        bool start_object(std::size_t) override
+        {
+            Push(false);
+
+            if (GetLocation() == Location::Property)
+            {
+                property = nullptr;
+                keyframes.clear();
+            }
+            else if (GetLocation() == Location::Keyframe)
+            {
+                keyframes.emplace_back(UNRESOLVED_PROPERTY, 0, Types::KeyframeValue());
+            }
+            return true;
+        }
+
+        bool key(string_t& value) override
+        {
+            currentKey = value;
+            return true;
+        }
+
+        bool end_object() override
+        {
+            if (GetLocation() == Location::Property)
+            {
+                if (!property)
+                {
+                    LOG_ERROR("Property object without a \"{0}\" node", NODE_PROPERTY);
+                    throw std::runtime_error("Missing property");
+                }
+
+                for (auto& k : keyframes)
+                    k.property = *property;
+                tracks.push_back(Track{property, std::move(keyframes)});
+                keyframes = {};
+            }
+
+            containers.pop_back();
+            return true;
+        }
+
+        bool start_array(std::size_t) override
+        {
+            Push(true);
+            return true;
+        }
+
+        bool end_array() override
+        {
+            containers.pop_back();
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) override
+        {
+            LOG_ERROR("Failed to parse keyframe file at byte {} ({})", position, e.what());
+            return false;
+        }
 
+       private:
+        enum class Location
+        {
+            Other,
+            Root,
+            PropertyArray,
+            Property,
+            KeyframeArray,
+            Keyframe,
+            Value,
+            ValueArray,
+            Interpolation,
+            InTangentArray,
+            OutTangentArray,
+        };
+
+        struct Container
+        {
+            Location location;
+            bool isArray;
+            uint32_t elementCount;
+        };
+
+        // Keyframes of the property object being parsed refer to this until the object's property is known
+        inline static const Types::KeyframeableProperty UNRESOLVED_PROPERTY{
+            Types::KeyframeablePropertyType::CampathCamera, "", Types::KeyframeValueType::CameraData, 0.0f, 0.0f};
+
+        std::string_view currentDemoName;
+        bool requireDemoMatch;
+
+        std::vector<Container> containers;
+        std::string currentKey;
+
+        const Types::KeyframeableProperty* property = nullptr;
+        std::vector<Types::Keyframe> keyframes;
+
+        Location GetLocation() const
+        {
+            return containers.empty() ? Location::Other : containers.back().location;
+        }
+
+        bool IsInArray() const
+        {
+            return !containers.empty() && containers.back().isArray;
+        }
+
+        // Index of the current element when inside an array
+        uint32_t GetElementIndex() const
+        {
+            return containers.empty() ? 0 : containers.back().elementCount;
+        }
+
+        void NextElement()
+        {
+            if (IsInArray())
+                containers.back().elementCount++;
+        }
+
+        void Push(bool isArray)
+        {
+            // containers are identified by their parent and, inside objects, the key they are stored under
+            auto location = Location::Other;
+            switch (GetLocation())
+            {
+                case Location::Other:
+                    if (containers.empty())
+                        location = Location::Root;
+                    break;
+                case Location::Root:
+                    if (currentKey == NODE_PROPERTIES)
+                        location = Location::PropertyArray;
+                    break;
+                case Location::PropertyArray:
+                    location = Location::Property;
+                    break;
+                case Location::Property:
+                    if (currentKey == NODE_KEYFRAMES)
+                        location = Location::KeyframeArray;
+                    break;
+                case Location::KeyframeArray:
+                    location = Location::Keyframe;
+                    break;
+                case Location::Keyframe:
+                    if (currentKey == NODE_VALUE)
+                        location = Location::Value;
+                    else if (currentKey == NODE_INTERPOLATION)
+                        location = Location::Interpolation;
+                    break;
+                case Location::Value:
+                    if (currentKey == NODE_VALUES)
+                        location = Location::ValueArray;
+                    break;
+                case Location::Interpolation:
+                    if (currentKey == NODE_IN_TANGENTS)
+                        location = Location::InTangentArray;
+                    else if (currentKey == NODE_OUT_TANGENTS)
+                        location = Location::OutTangentArray;
+                    break;
+                default:
+                    break;
+            }
+
+            NextElement();
+            containers.push_back({location, isArray, 0});
+        }
+
+        void Number(double value)
+        {
+            const auto index = GetElementIndex();
+            const bool indexInRange = index < Types::KeyframeInterpolation::MAX_VALUE_COUNT;
+
+            switch (GetLocation())
+            {
+                case Location::Root:
+                    if (currentKey == NODE_FROZEN_TICK)
+                        frozenTick = static_cast<uint32_t>(value);
+                    break;
+                case Location::Keyframe:
+                    if (currentKey == NODE_TICK)
+                        keyframes.back().tick = static_cast<uint32_t>(value);
+                    break;
+                case Location::ValueArray:
+                    if (indexInRange)
+                        keyframes.back().value.SetByIndex(index, static_cast<float>(value));
+                    break;
+                case Location::Interpolation:
+                    if (currentKey == NODE_TENSION)
+                        keyframes.back().interpolation.EditParameters().tension = static_cast<float>(value);
+                    else if (currentKey == NODE_CONTINUITY)
+                        keyframes.back().interpolation.EditParameters().continuity = static_cast<float>(value);
+                    else if (currentKey == NODE_BIAS)
+                        keyframes.back().interpolation.EditParameters().bias = static_cast<float>(value);
+                    break;
+                case Location::InTangentArray:
+                    if (indexInRange)
+                        keyframes.back().interpolation.EditParameters().inTangents[index] = static_cast<float>(value);
+                    break;
+                case Location::OutTangentArray:
+                    if (indexInRange)
+                        keyframes.back().interpolation.EditParameters().outTangents[index] = static_cast<float>(value);
+                    break;
+                default:
+                    break;
+            }
+
+            NextElement();
+        }
+    };
+
+    void ReadJson(const std::filesystem::path& path, bool requireDemoMatch)
+    {
         std::ifstream file(path);
         if (!file.is_open())
         {
@@ -116,9 +518,280 @@ namespace IWXMVM::Components
 
         try
         {
-            json rootNode = json::parse(file);
+            const auto currentDemoName = Mod::GetGameInterface()->GetDemoInfo().name;
 
-            auto gameName = rootNode[NODE_GAME_NAME].get<std::string>();
+            KeyframeJsonHandler handler(currentDemoName, requireDemoMatch);
+            const bool parsed = nlohmann::json::sax_parse(file, &handler);
+            if (handler.skippedDemo)
+            {
+                LOG_INFO("Not loading keyframes since this demo is not the previous demo");
+                return;
+            }
+            if (!parsed)
+                return;
+
+            auto currentGameName = magic_enum::enum_name(Mod::GetGameInterface()->GetGame());
+            if (handler.gameName.compare(currentGameName) != 0)
+            {
+                LOG_WARN("Game of loaded keyframes file doesnt match current game!");
+                LOG_WARN("Expected: {0}", handler.gameName);
+                LOG_WARN("Actual: {0}", currentGameName);
+            }
+
+            if (handler.demoName.compare(currentDemoName) != 0)
+            {
+                LOG_WARN("Demo names dont match {0} vs {1}", handler.demoName, currentDemoName);
+                LOG_WARN("Expected: {0}", handler.demoName);
+                LOG_WARN("Actual: {0}", currentDemoName);
+            }
+
+            Components::Playback::HandleImportedFrozenTickLogic(handler.frozenTick);
+
+            for (auto& track : handler.tracks)
+            {
+                // files may hold their keyframes in any order
+                AddLoadedKeyframes(*track.property, std::move(track.keyframes));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Failed to parse keyframe file ({})", e.what());
+        }
+    }
+
+    // Binary project format: a file header followed by one block per track, each holding contiguous tick, value and
+    // interpolation arrays. All fields are little endian and 4 byte aligned, so the arrays can be copied out of the
+    // file in one go instead of being parsed keyframe by keyframe.
+    constexpr std::array<char, 4> BINARY_MAGIC = {'I', 'W', 'X', 'K'};
+    // 2: interpolation parameters are only written for keyframes that have them
+    constexpr uint32_t BINARY_VERSION = 2;
+    constexpr std::string_view BINARY_EXTENSION = ".iwxk";
+
+    struct BinaryFileHeader
+    {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t hasFrozenTick;
+        uint32_t frozenTick;
+        uint32_t trackCount;
+        // followed by the game and demo name
+    };
+
+    struct BinaryTrackHeader
+    {
+        uint32_t valueCount;
+        uint32_t keyframeCount;
+        // followed by the property name, then keyframeCount ticks, keyframeCount * valueCount values,
+        // keyframeCount interpolation modes, the number of interpolation parameter records and the records
+    };
+
+    // Interpolation parameters of the keyframe at the given position in its track
+    struct BinaryParameters
+    {
+        uint32_t keyframeIndex;
+        Types::KeyframeInterpolation::Parameters parameters;
+    };
+    static_assert(sizeof(BinaryParameters) == sizeof(uint32_t) * 18);
+
+    class BinaryWriter
+    {
+       public:
+        template <typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void WriteArray(const std::vector<T>& values)
+        {
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        }
+
+        void WriteString(std::string_view string)
+        {
+            Write(static_cast<uint32_t>(string.size()));
+            WriteBytes(string.data(), string.size());
+            buffer.resize((buffer.size() + 3) & ~std::size_t{3});
+        }
+
+        std::vector<char> TakeBuffer()
+        {
+            return std::move(buffer);
+        }
+
+       private:
+        void WriteBytes(const void* data, std::size_t size)
+        {
+            const auto bytes = static_cast<const char*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + size);
+        }
+
+        std::vector<char> buffer;
+    };
+
+    class BinaryReader
+    {
+       public:
+        explicit BinaryReader(std::span<const char> data) : data(data)
+        {
+        }
+
+        template <typename T>
+        T Read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            ReadBytes(&value, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void ReadArray(std::vector<T>& values, std::size_t count)
+        {
+            values.resize(count);
+            ReadBytes(values.data(), count * sizeof(T));
+        }
+
+        std::string ReadString()
+        {
+            const auto size = Read<uint32_t>();
+            std::string string(size, '\0');
+            ReadBytes(string.data(), size);
+            offset = (offset + 3) & ~std::size_t{3};
+            return string;
+        }
+
+       private:
+        void ReadBytes(void* destination, std::size_t size)
+        {
+            if (size > data.size() - offset)
+                throw std::runtime_error("Unexpected end of file");
+
+            std::memcpy(destination, data.data() + offset, size);
+            offset += size;
+        }
+
+        std::span<const char> data;
+        std::size_t offset = 0;
+    };
+
+    KeyframeSerializer::Snapshot KeyframeSerializer::TakeSnapshot()
+    {
+        // the KeyframeManager sorts tracks before anything is journaled, which is when snapshots are taken
+#ifndef NDEBUG
+        for (const auto& [_, ks] : KeyframeManager::Get().GetKeyframes())
+            assert(std::is_sorted(ks.begin(), ks.end(), [](const auto& a, const auto& b) { return a.tick < b.tick; }));
+#endif
+
+        return Snapshot{
+            .frozenTick = Components::Playback::GetFrozenTick(),
+            .gameName = std::string(magic_enum::enum_name(Mod::GetGameInterface()->GetGame())),
+            .demoName = Mod::GetGameInterface()->GetDemoInfo().name,
+            .keyframes = KeyframeManager::Get().GetKeyframes(),
+        };
+    }
+
+    std::vector<char> KeyframeSerializer::WriteBinary(const Snapshot& snapshot)
+    {
+        BinaryWriter writer;
+        writer.Write(BinaryFileHeader{
+            .magic = BINARY_MAGIC,
+            .version = BINARY_VERSION,
+            .hasFrozenTick = snapshot.frozenTick.has_value(),
+            .frozenTick = snapshot.frozenTick.value_or(0),
+            .trackCount = static_cast<uint32_t>(snapshot.keyframes.size()),
+        });
+        writer.WriteString(snapshot.gameName);
+        writer.WriteString(snapshot.demoName);
+
+        std::vector<uint32_t> ticks;
+        std::vector<float> values;
+        std::vector<uint32_t> modes;
+        std::vector<BinaryParameters> parameters;
+        for (const auto& [p, ks] : snapshot.keyframes)
+        {
+            const auto valueCount = static_cast<uint32_t>(p.GetValueCount());
+
+            ticks.clear();
+            values.resize(ks.size() * valueCount);
+            modes.clear();
+            parameters.clear();
+            for (const auto& k : ks)
+            {
+                std::memcpy(values.data() + ticks.size() * valueCount, &k.value, valueCount * sizeof(float));
+                ticks.push_back(k.tick);
+                modes.push_back(static_cast<uint32_t>(k.interpolation.mode));
+                if (k.interpolation.HasParameters())
+                    parameters.push_back({static_cast<uint32_t>(ticks.size() - 1), k.interpolation.GetParameters()});
+            }
+
+            writer.Write(BinaryTrackHeader{valueCount, static_cast<uint32_t>(ks.size())});
+            writer.WriteString(magic_enum::enum_name(p.type));
+            writer.WriteArray(ticks);
+            writer.WriteArray(values);
+            writer.WriteArray(modes);
+            writer.Write(static_cast<uint32_t>(parameters.size()));
+            writer.WriteArray(parameters);
+        }
+
+        return writer.TakeBuffer();
+    }
+
+    void WriteBinaryFile(const std::filesystem::path& path)
+    {
+        if (!std::filesystem::exists(path.parent_path()))
+        {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        const auto buffer = KeyframeSerializer::WriteBinary(KeyframeSerializer::TakeSnapshot());
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Failed to write keyframe file at {}", path.string());
+            return;
+        }
+
+        file.write(buffer.data(), buffer.size());
+        file.close();
+        if (file.fail())
+            LOG_ERROR("Failed to write keyframe file at {}", path.string());
+    }
+
+    void ReadBinary(const std::filesystem::path& path, bool requireDemoMatch)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Failed to read keyframe file at {}", path.string());
+            return;
+        }
+
+        std::vector<char> data(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(data.data(), data.size());
+        file.close();
+
+        try
+        {
+            BinaryReader reader(data);
+
+            const auto header = reader.Read<BinaryFileHeader>();
+            if (header.magic != BINARY_MAGIC)
+            {
+                LOG_ERROR("{} is not a keyframe file", path.string());
+                return;
+            }
+            if (header.version != BINARY_VERSION)
+            {
+                LOG_ERROR("Keyframe file version {} is not supported (expected {})", header.version, BINARY_VERSION);
+                return;
+            }
+
+            auto gameName = reader.ReadString();
             auto currentGameName = magic_enum::enum_name(Mod::GetGameInterface()->GetGame());
             if (gameName.compare(currentGameName) != 0)
             {
@@ -127,7 +800,7 @@ namespace IWXMVM::Components
                 LOG_WARN("Actual: {0}", currentGameName);
             }
 
-            auto demoName = rootNode[NODE_DEMO_NAME].get<std::string>();
+            auto demoName = reader.ReadString();
             auto currentDemoName = Mod::GetGameInterface()->GetDemoInfo().name;
             if (demoName.compare(currentDemoName) != 0)
             {
@@ -142,15 +815,17 @@ namespace IWXMVM::Components
                 LOG_WARN("Actual: {0}", currentDemoName);
             }
 
-            auto optFrozenTick = rootNode[NODE_FROZEN_TICK];
-            Components::Playback::HandleImportedFrozenTickLogic(
-                !optFrozenTick.is_null() ? std::optional{optFrozenTick.get<std::uint32_t>()} : std::nullopt);
+            // tracks are only added once the whole file was read, so a truncated file doesn't load partially
+            std::vector<std::pair<const Types::KeyframeableProperty*, std::vector<Types::Keyframe>>> tracks;
 
-            auto properties = rootNode[NODE_PROPERTIES];
-            for (json::iterator propertyObject = properties.begin(); propertyObject != properties.end();
-                 ++propertyObject)
+            std::vector<uint32_t> ticks;
+            std::vector<float> values;
+            std::vector<uint32_t> modes;
+            std::vector<BinaryParameters> parameters;
+            for (uint32_t t = 0; t < header.trackCount; t++)
             {
-                auto propertyName = (*propertyObject)[NODE_PROPERTY].get<std::string>();
+                const auto trackHeader = reader.Read<BinaryTrackHeader>();
+                const auto propertyName = reader.ReadString();
 
                 auto propertyType = magic_enum::enum_cast<Types::KeyframeablePropertyType>(propertyName);
                 if (!propertyType.has_value())
@@ -158,36 +833,79 @@ namespace IWXMVM::Components
                     LOG_ERROR("Unknown property \"{0}\"", propertyName);
                     throw std::runtime_error("Unknown property encountered");
                 }
-                auto property = Components::KeyframeManager::Get().GetProperty(propertyType.value());
+                const auto& property = Components::KeyframeManager::Get().GetProperty(propertyType.value());
+                if (trackHeader.valueCount != static_cast<uint32_t>(property.GetValueCount()))
+                {
+                    LOG_ERROR("Property \"{0}\" has {1} values instead of {2}", propertyName, trackHeader.valueCount,
+                              property.GetValueCount());
+                    throw std::runtime_error("Value count mismatch");
+                }
 
-                auto& keyframes = Components::KeyframeManager::Get().GetKeyframes(property);
-                for (json::iterator keyframe = propertyObject->at(NODE_KEYFRAMES).begin();
-                     keyframe != propertyObject->at(NODE_KEYFRAMES).end(); ++keyframe)
+                reader.ReadArray(ticks, trackHeader.keyframeCount);
+                reader.ReadArray(values, static_cast<std::size_t>(trackHeader.keyframeCount) * trackHeader.valueCount);
+                reader.ReadArray(modes, trackHeader.keyframeCount);
+                reader.ReadArray(parameters, reader.Read<uint32_t>());
+
+                // interpolation modes are numbered from 0 without gaps, so a range check validates all of them
+                const auto invalidMode = std::ranges::find_if(modes, [](uint32_t mode) {
+                    return mode >= magic_enum::enum_count<Types::KeyframeInterpolationMode>();
+                });
+                if (invalidMode != modes.end())
                 {
-                    auto tick = keyframe->at(NODE_TICK).get<uint32_t>();
-                    auto valueNode = keyframe->at(NODE_VALUE);
-                    auto valueTypeName = valueNode[NODE_TYPE].get<std::string>();
-                    auto valueType = magic_enum::enum_cast<Types::KeyframeValueType>(valueTypeName);
-                    if (!valueType.has_value())
-                    {
-                        LOG_ERROR("Unknown value type \"{0}\"", valueTypeName);
-                        throw std::runtime_error("Unknown value type encountered");
-                    }
-                    Types::KeyframeValue value = ReadValueOfType(valueType.value(), valueNode[NODE_VALUES]);
+                    LOG_ERROR("Unknown interpolation mode {0}", *invalidMode);
+                    throw std::runtime_error("Unknown interpolation mode encountered");
+                }
+
+                auto& keyframes = tracks.emplace_back(&property, std::vector<Types::Keyframe>()).second;
+                keyframes.reserve(trackHeader.keyframeCount);
+                const float* value = values.data();
+                for (uint32_t i = 0; i < trackHeader.keyframeCount; i++, value += trackHeader.valueCount)
+                {
+                    auto& keyframe = keyframes.emplace_back(property, ticks[i], Types::KeyframeValue());
+                    std::memcpy(&keyframe.value, value, trackHeader.valueCount * sizeof(float));
+                    keyframe.interpolation.mode = static_cast<Types::KeyframeInterpolationMode>(modes[i]);
+                }
 
-                    keyframes.push_back(Types::Keyframe(property, tick, Types::KeyframeValue(value)));
+                for (const auto& [keyframeIndex, keyframeParameters] : parameters)
+                {
+                    if (keyframeIndex >= keyframes.size())
+                        throw std::runtime_error("Interpolation parameters of a keyframe that doesn't exist");
+                    keyframes[keyframeIndex].interpolation.EditParameters() = keyframeParameters;
                 }
             }
+
+            Components::Playback::HandleImportedFrozenTickLogic(
+                header.hasFrozenTick ? std::optional{header.frozenTick} : std::nullopt);
+
+            for (auto& [property, trackKeyframes] : tracks)
+            {
+                AddLoadedKeyframes(*property, std::move(trackKeyframes));
+            }
         }
         catch (const std::exception& e)
         {
-            LOG_ERROR("Failed to parse keyframe file ({})", e.what());
+            LOG_ERROR("Failed to read keyframe file ({})", e.what());
         }
     }
 
-    std::filesystem::path GetRecentKeyframesPath()
+    void KeyframeSerializer::Write(std::filesystem::path path)
     {
-        return PathUtils::GetIWXMVMPath() / "keyframes";
+        PROFILE_FUNCTION();
+
+        if (path.extension() == BINARY_EXTENSION)
+            WriteBinaryFile(path);
+        else
+            WriteJson(path);
+    }
+
+    void KeyframeSerializer::Read(std::filesystem::path path, bool requireDemoMatch)
+    {
+        PROFILE_FUNCTION();
+
+        if (path.extension() == BINARY_EXTENSION)
+            ReadBinary(path, requireDemoMatch);
+        else
+            ReadJson(path, requireDemoMatch);
     }
 
     auto GetDemoNameHash()
@@ -196,14 +914,20 @@ namespace IWXMVM::Components
         return std::hash<std::string>{}(demoName);
     }
 
-    void KeyframeSerializer::WriteRecent()
+    std::filesystem::path KeyframeSerializer::GetRecentPath()
     {
-        Write(GetRecentKeyframesPath() / std::format("{:X}.json", GetDemoNameHash()));
+        return PathUtils::GetIWXMVMPath() / "keyframes" / std::format("{:X}{}", GetDemoNameHash(), BINARY_EXTENSION);
     }
 
     void KeyframeSerializer::ReadRecent()
     {
-        auto path = GetRecentKeyframesPath() / std::format("{:X}.json", GetDemoNameHash());
+        auto path = GetRecentPath();
+        if (!std::filesystem::exists(path))
+        {
+            // sessions from before the binary format was introduced
+            path.replace_extension(".json");
+        }
+
         if (std::filesystem::exists(path))
         {
             LOG_INFO("Reading last sessions keyframes for this demo...");
@@ -1,13 +1,29 @@
 #pragma once
+#include "Types/Keyframe.hpp"
 
 namespace IWXMVM::Components
 {
     namespace KeyframeSerializer
     {
+        // Copy of everything the binary format holds, so it can be encoded off the main thread
+        struct Snapshot
+        {
+            std::optional<uint32_t> frozenTick;
+            std::string gameName;
+            std::string demoName;
+            std::map<Types::KeyframeableProperty, std::vector<Types::Keyframe>> keyframes;
+        };
+        Snapshot TakeSnapshot();
+
+        // Both pick the JSON or the binary format based on the file extension
         void Write(std::filesystem::path path);
         void Read(std::filesystem::path path, bool requireDemoMatch = false);
 
-        void WriteRecent();
+        // All keyframes in the binary format, tracks in the order of KeyframeManager::GetKeyframes
+        std::vector<char> WriteBinary(const Snapshot& snapshot);
+
+        // Last session's keyframes for the current demo, kept up to date by the KeyframeJournal
+        std::filesystem::path GetRecentPath();
         void ReadRecent();
     }  // namespace KeyframeSerializer
 }  // namespace IWXMVM::Components
\ No newline at end of file
@@ -2,7 +2,10 @@
 #include "Playback.hpp"
 
 #include "Mod.hpp"
+#include "KeyframeManager.hpp"
 #include "Rewinding.hpp"
+#include "Utilities/Profiler.hpp"
+#include "Utilities/TimeRemapTable.hpp"
 
 namespace IWXMVM::Components::Playback
 {
@@ -10,6 +13,30 @@ namespace IWXMVM::Components::Playback
     uint32_t timelineTick = 0;
     std::optional<uint32_t> frozenTick = std::nullopt;
 
+    uint32_t fractionTick = 0;
+    double tickFraction = 0.0;
+
+    MathUtils::TimeRemapTable timeRemapTable;
+    std::optional<uint32_t> timeRemapTableRevision;
+    double remappedTick = 0.0;
+
+    Types::DvarHandle timescaleDvar("timescale");
+    Types::DvarHandle comMaxFpsDvar("com_maxfps");
+
+    struct FastSeek
+    {
+        std::int32_t targetServerTime;
+        std::chrono::steady_clock::time_point startTime;
+        std::int32_t frameCount;
+        std::optional<std::int32_t> previousMaxFps;
+    };
+
+    // a seek that doesn't reach its target in this many frames (e.g. past the end of the demo) is given up on
+    constexpr std::int32_t FAST_SEEK_MAX_FRAMES = 500;
+
+    std::optional<FastSeek> fastSeek;
+    std::optional<float> lastFastSeekDuration;
+
     void TogglePaused()
     {
         isPlaybackPaused = !isPlaybackPaused;
@@ -35,6 +62,21 @@ namespace IWXMVM::Components::Playback
         timelineTick = tick;
     }
 
+    void SetTickFraction(uint32_t tick, double fraction)
+    {
+        fractionTick = tick;
+        tickFraction = fraction;
+    }
+
+    double GetPreciseTimelineTick()
+    {
+        const auto tick = GetTimelineTick();
+        if (tick != fractionTick)
+            return tick;
+
+        return tick + tickFraction;
+    }
+
     std::optional<uint32_t> GetFrozenTick()
     {
         return frozenTick;
@@ -71,11 +113,88 @@ namespace IWXMVM::Components::Playback
     void SkipDemoForward(std::int32_t ticks)
     {
         auto addresses = Mod::GetGameInterface()->GetPlaybackDataAddresses();
+        if (ticks >= FAST_SEEK_MIN_TICKS)
+            BeginFastSeek(*reinterpret_cast<int32_t*>(addresses.cl.serverTime) + ticks);
+
         auto realtime = reinterpret_cast<int32_t*>(addresses.cls.realtime);
         *realtime = *realtime + ticks;
         LOG_DEBUG("Skipping forward {} ticks, realtime: {}", ticks, *realtime);
     }
 
+    void BeginFastSeek(std::int32_t targetServerTime)
+    {
+        // the catch-up after a rewind is part of the same seek
+        if (fastSeek.has_value())
+        {
+            fastSeek->targetServerTime = targetServerTime;
+            return;
+        }
+
+        fastSeek = FastSeek{targetServerTime, std::chrono::steady_clock::now(), 0, std::nullopt};
+
+        const std::optional<Types::Dvar> com_maxfps = Mod::GetGameInterface()->GetCachedDvar(comMaxFpsDvar);
+        if (com_maxfps.has_value())
+        {
+            fastSeek->previousMaxFps = com_maxfps.value().value->int32;
+            com_maxfps.value().value->int32 = 0;
+        }
+    }
+
+    void EndFastSeek(bool reachedTarget)
+    {
+        const auto duration = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() -
+                                                                      fastSeek->startTime).count();
+
+        // don't override a frame limit that was changed while seeking
+        const std::optional<Types::Dvar> com_maxfps = Mod::GetGameInterface()->GetCachedDvar(comMaxFpsDvar);
+        if (fastSeek->previousMaxFps.has_value() && com_maxfps.has_value() && com_maxfps.value().value->int32 == 0)
+            com_maxfps.value().value->int32 = fastSeek->previousMaxFps.value();
+
+        if (reachedTarget)
+        {
+            LOG_INFO("Seeked to server time {} in {:.1f} ms ({} frames)", fastSeek->targetServerTime, duration,
+                     fastSeek->frameCount);
+            lastFastSeekDuration = duration;
+        }
+        else
+        {
+            LOG_DEBUG("Stopped seeking to server time {} after {} frames", fastSeek->targetServerTime,
+                      fastSeek->frameCount);
+        }
+
+        fastSeek.reset();
+    }
+
+    void UpdateFastSeek()
+    {
+        if (!fastSeek.has_value())
+            return;
+
+        if (Mod::GetGameInterface()->GetGameState() != Types::GameState::InDemo)
+        {
+            EndFastSeek(false);
+            return;
+        }
+
+        // the game has processed the previous frame by now, including any skip that was requested in it
+        auto addresses = Mod::GetGameInterface()->GetPlaybackDataAddresses();
+        const auto serverTime = *reinterpret_cast<int32_t*>(addresses.cl.serverTime);
+        if (!Rewinding::IsRewinding() && serverTime >= fastSeek->targetServerTime)
+            EndFastSeek(true);
+        else if (++fastSeek->frameCount >= FAST_SEEK_MAX_FRAMES)
+            EndFastSeek(false);
+    }
+
+    bool IsFastSeeking()
+    {
+        return fastSeek.has_value();
+    }
+
+    std::optional<float> GetLastFastSeekDuration()
+    {
+        return lastFastSeekDuration;
+    }
+
     void SetTickDelta(int32_t value, bool ignoreDeadzone)
     {
         if (value > 0)
@@ -148,6 +267,51 @@ namespace IWXMVM::Components::Playback
         assert(std::accumulate(pattern.begin(), pattern.end(), 0) > 0);
     }
 
+    bool UpdateTimeRemapTable()
+    {
+        auto& keyframeManager = KeyframeManager::Get();
+        const auto& property = keyframeManager.GetProperty(Types::KeyframeablePropertyType::PlaybackSpeed);
+        const auto& keyframes = keyframeManager.GetKeyframes(property);
+        if (keyframes.empty())
+            return false;
+
+        const auto revision = keyframeManager.GetKeyframesRevision(property);
+        if (timeRemapTableRevision != revision)
+        {
+            const auto& segmentTable = keyframeManager.GetSegmentTable(property);
+            timeRemapTable.Update(keyframes, [&](float tick) { return segmentTable.Evaluate(tick).floatingPoint; });
+            timeRemapTableRevision = revision;
+        }
+        return true;
+    }
+
+    double GetOutputDuration(uint32_t startTick, uint32_t endTick)
+    {
+        if (!UpdateTimeRemapTable())
+            return static_cast<double>(endTick) - static_cast<double>(startTick);
+
+        return timeRemapTable.GetOutputTime(endTick) - timeRemapTable.GetOutputTime(startTick);
+    }
+
+    std::optional<std::int32_t> CalculateRemappedDelta(double frameMilliseconds)
+    {
+        if (!UpdateTimeRemapTable())
+            return std::nullopt;
+
+        // the fractional part of the tick is carried over to the next frame, unless the tick was changed by something
+        // else in the meantime (skipping, rewinding or loading another demo)
+        const auto tick = GetTimelineTick();
+        if (remappedTick < tick || remappedTick >= tick + 1.0)
+            remappedTick = tick;
+
+        const auto outputTime = timeRemapTable.GetOutputTime(remappedTick) + frameMilliseconds;
+        remappedTick = timeRemapTable.GetTickAtOutputTime(outputTime);
+
+        const auto nextTick = std::floor(remappedTick);
+        SetTickFraction(static_cast<uint32_t>(nextTick), remappedTick - nextTick);
+        return static_cast<std::int32_t>(nextTick - tick);
+    }
+
     std::int32_t CalculatePlaybackDeltaInternal(std::int32_t gameMsec)
     {
         // check if we need to skip forward for exact rewinding
@@ -174,14 +338,21 @@ namespace IWXMVM::Components::Playback
             return 0;
         }
 
-        const std::optional<Types::Dvar> timescale = Mod::GetGameInterface()->GetDvar("timescale");
+        // a keyframed playback speed takes precedence over the timescale
+        if (const auto remappedDelta = CalculateRemappedDelta(ImGui::GetIO().DeltaTime * 1000.0);
+            remappedDelta.has_value())
+        {
+            return remappedDelta.value();
+        }
+
+        const std::optional<Types::Dvar> timescale = Mod::GetGameInterface()->GetCachedDvar(timescaleDvar);
 
         // we can use the original msec value when its value is greater than 1, and/or when timescale is equal or
         // greater than 1.0
         if (gameMsec > 1 || !timescale.has_value() || timescale.value().value->floating_point >= 1.0f)
             return gameMsec;
 
-        const std::optional<Types::Dvar> com_maxfps = Mod::GetGameInterface()->GetDvar("com_maxfps");
+        const std::optional<Types::Dvar> com_maxfps = Mod::GetGameInterface()->GetCachedDvar(comMaxFpsDvar);
         if (!com_maxfps.has_value())
             return gameMsec;
 
@@ -225,6 +396,10 @@ namespace IWXMVM::Components::Playback
 
     std::int32_t CalculatePlaybackDelta(std::int32_t gameMsec)
     {
+        PROFILE_FUNCTION();
+
+        UpdateFastSeek();
+
         auto delta = CalculatePlaybackDeltaInternal(gameMsec);
 
         if (IsGameFrozen() && !Components::Rewinding::IsRewinding())
@@ -10,12 +10,18 @@ namespace IWXMVM::Components
             2.0f, 5.0f, 10.0f, 20.0f, 50.0f
         };
         constexpr int32_t REWIND_DEADZONE = 250;
+        constexpr int32_t FAST_SEEK_MIN_TICKS = 1000;
         void TogglePaused();
         bool IsPaused();
 
         uint32_t GetTimelineTick();
         void SetTimelineTick(uint32_t tick);
 
+        // Frames don't always fall on a whole tick, the fraction is kept for evaluating keyframes in between ticks. It
+        // only applies while the timeline is at the given tick.
+        void SetTickFraction(uint32_t tick, double fraction);
+        double GetPreciseTimelineTick();
+
         void ToggleFrozenTick();
         std::optional<uint32_t> GetFrozenTick();
         bool IsGameFrozen();
@@ -24,8 +30,22 @@ namespace IWXMVM::Components
         void SkipDemoForward(std::int32_t ticks);
         void SetTickDelta(std::int32_t value, bool ignoreDeadzone = false);
 
+        // Skips of at least FAST_SEEK_MIN_TICKS and all rewinds run as a fast seek: until the target server time is
+        // reached, the overlay isn't redrawn and the frame limit is lifted, so the game only processes the demo
+        void BeginFastSeek(std::int32_t targetServerTime);
+        bool IsFastSeeking();
+        std::optional<float> GetLastFastSeekDuration();
+
         void HandleImportedFrozenTickLogic(std::optional<std::uint32_t> frozenTick);
 
+        // Milliseconds of output between two ticks, which only differs from the tick difference when the playback
+        // speed is keyframed
+        double GetOutputDuration(uint32_t startTick, uint32_t endTick);
+
+        // Returns how many ticks to advance over a frame of the given duration when the playback speed is keyframed,
+        // and nothing when it isn't
+        std::optional<std::int32_t> CalculateRemappedDelta(double frameMilliseconds);
+
         std::int32_t CalculatePlaybackDelta(std::int32_t gameMsec);
     } // namespace Playback
 }  // namespace IWXMVM::Components
\ No newline at end of file
@@ -1,17 +1,17 @@
 #include "StdInclude.hpp"
 #include "Rewinding.hpp"
 
+#include "DemoReadTrace.hpp"
 #include "Playback.hpp"
 #include "Mod.hpp"
 #include "Events.hpp"
+#include "Utilities/DemoReads.hpp"
+#include "Utilities/Profiler.hpp"
 
 namespace IWXMVM::Components::Rewinding
 {
     struct InitialGamestate
     {
-        bool populated = false;
-        int fileOffset = 0;
-
         int serverTime = 0;
         int serverConfigDataSequence = 0;
         int lastExecutedServerCommand = 0;
@@ -32,8 +32,7 @@ namespace IWXMVM::Components::Rewinding
 
     FilestreamState filestreamState = FilestreamState::Uninitialized;
     std::ifstream demoFile;
-    uint32_t demoFileSize = 0;
-    uint32_t demoFileOffset = 0;
+    DemoReads::DemoFileState demoFileState;
     std::unique_ptr<InitialGamestate> initialGamestate;
 
     inline constexpr std::int32_t NOT_IN_USE = -1;
@@ -50,8 +49,7 @@ namespace IWXMVM::Components::Rewinding
         {
             demoFile.close();
         }
-        demoFileSize = 0;
-        demoFileOffset = 0;
+        demoFileState = {};
         initialGamestate.reset();
         latestRewindTo = NOT_IN_USE;
         rewindTo.store(NOT_IN_USE);
@@ -59,6 +57,8 @@ namespace IWXMVM::Components::Rewinding
 
     void RestoreOldGamestate(auto wouldReadDemoFooter)
     {
+        PROFILE_FUNCTION();
+
         if (initialGamestate == nullptr || latestRewindTo > 0)
             return;
 
@@ -94,8 +94,8 @@ namespace IWXMVM::Components::Rewinding
         Mod::GetGameInterface()->CL_FirstSnapshot();
 
         LOG_DEBUG("Rewound and time is now: {}", initialGamestate->serverTime);
-        demoFileOffset = initialGamestate->fileOffset;
-        demoFile.seekg(demoFileOffset);
+        DemoReads::RestartFile(demoFileState);
+        demoFile.seekg(demoFileState.offset);
 
         auto addresses = Mod::GetGameInterface()->GetPlaybackDataAddresses();
         *reinterpret_cast<int*>(addresses.cl.parseEntitiesNum) = 0;
@@ -124,26 +124,17 @@ namespace IWXMVM::Components::Rewinding
         rewindTo.store(SKIPPING_FORWARD);
     }
     
-    void StoreCurrentGamestate(int len)
+    void StoreCurrentGamestate(DemoReads::DemoReadType readType)
     {
         auto addresses = Mod::GetGameInterface()->GetPlaybackDataAddresses();
 
-        // TODO: find a more robust method of detecting a gamestate message
-        if (len >= 10'000 || demoFileOffset == 9)
+        if (readType == DemoReads::DemoReadType::Gamestate)
         {
-            // first message with the gamestate; triggers the game to load a map
-            if (initialGamestate != nullptr)
-            {
-                // clear old data in case this not the first gamestate in the demo
-                initialGamestate.reset();
-            }
+            initialGamestate.reset();
         }
-        else if (initialGamestate == nullptr)
+        else if (readType == DemoReads::DemoReadType::FirstMessage)
         {
-            // after gamestate before first snapshot
             initialGamestate = std::make_unique<InitialGamestate>();
-            initialGamestate->fileOffset = demoFileOffset - 9;
-            assert(initialGamestate->fileOffset > 0);
 
             initialGamestate->lastExecutedServerCommand =
                 *reinterpret_cast<int*>(addresses.clc.lastExecutedServerCommand);
@@ -163,10 +154,8 @@ namespace IWXMVM::Components::Rewinding
                    addresses.clientInfo.size);
             memcpy(initialGamestate->gameState, reinterpret_cast<char*>(addresses.gameState.address), addresses.gameState.size);
         }
-        else if (!initialGamestate->populated)
+        else if (readType == DemoReads::DemoReadType::FirstSnapshot && initialGamestate != nullptr)
         {
-            // after first snapshot and before second snapshot
-            initialGamestate->populated = true;
             initialGamestate->serverTime = *reinterpret_cast<int*>(addresses.cl.snap_serverTime);
             assert(initialGamestate->serverTime > 0);
         }
@@ -198,6 +187,8 @@ namespace IWXMVM::Components::Rewinding
 
     void RewindBy(std::int32_t ticks)
     {
+        PROFILE_FUNCTION();
+
         if (Playback::IsGameFrozen())
         {
             Playback::SetTimelineTick(Playback::GetTimelineTick() + ticks);
@@ -221,6 +212,8 @@ namespace IWXMVM::Components::Rewinding
             return;
         }
 
+        Playback::BeginFastSeek(*reinterpret_cast<int*>(addresses.cl.serverTime) + ticks);
+
         LOG_DEBUG("Rewinding back {} ticks", ticks);
     }
 
@@ -238,7 +231,7 @@ namespace IWXMVM::Components::Rewinding
             else
             {
                 demoFile.seekg(0, std::ios::end);
-                demoFileSize = (uint32_t)demoFile.tellg();
+                demoFileState.size = (uint32_t)demoFile.tellg();
                 demoFile.seekg(0, std::ios::beg);
 
                 filestreamState = FilestreamState::Initialized;
@@ -249,26 +242,31 @@ namespace IWXMVM::Components::Rewinding
         if (filestreamState != FilestreamState::Initialized)
             return -1;
 
-        // only reset when the game has just requested the one byte message type
-        if (len == 1)
+        const auto readType = DemoReads::BeginRead(demoFileState, len);
+        if (readType == DemoReads::DemoReadType::MessageType || readType == DemoReads::DemoReadType::Footer)
         {
-            auto wouldReadDemoFooter = demoFileOffset + 9 >= demoFileSize;
-            RestoreOldGamestate(wouldReadDemoFooter);
+            RestoreOldGamestate(readType == DemoReads::DemoReadType::Footer);
         }
         else if (len > 12)
         {
             // execute server commands here otherwise they may be lost when skipping forward a lot
             Mod::GetGameInterface()->ExecuteNewServerCommands();
 
-            // to exclude client archives (and CoD4X protocol header)
-            StoreCurrentGamestate(len);
+            StoreCurrentGamestate(readType);
+        }
+
+        if (DemoReadTrace::IsRecording())
+        {
+            auto addresses = Mod::GetGameInterface()->GetPlaybackDataAddresses();
+            DemoReadTrace::RecordRead(demoFileState.offset, static_cast<uint32_t>(demoFile.tellg()),
+                                      static_cast<uint32_t>(len), *reinterpret_cast<int*>(addresses.cl.serverTime));
         }
 
         demoFile.read(reinterpret_cast<char*>(buffer), len);
-        demoFileOffset += len;
+        DemoReads::FinishRead(demoFileState, len);
 
         // gets triggered when a demo is loaded when playing another demo!
-        assert(demoFileOffset == demoFile.tellg());
+        assert(demoFileState.offset == demoFile.tellg());
 
         return len;
     }
@@ -12,6 +12,7 @@ namespace IWXMVM
             defaults[Action::DollyAddNode]         = Bind{ImGuiKey_K, "DollyAddNode"};
             defaults[Action::DollyClearNodes]      = Bind{ImGuiKey_L, "DollyClearNodes"};
             defaults[Action::DollyPlayPath]        = Bind{ImGuiKey_J, "DollyPlayPath"};
+            defaults[Action::DollyRecordPath]      = Bind{ImGuiKey_H, "DollyRecordPath"};
             defaults[Action::FreeCameraActivate]   = Bind{ImGuiKey_F, "FreeCameraActivate"};
             defaults[Action::FreeCameraForward]    = Bind{ImGuiKey_W, "FreeCameraForward"};
             defaults[Action::FreeCameraBackward]   = Bind{ImGuiKey_S, "FreeCameraBackward"};
@@ -8,6 +8,7 @@ namespace IWXMVM
         DollyAddNode,
         DollyClearNodes,
         DollyPlayPath,
+        DollyRecordPath,
         FreeCameraActivate,
         FreeCameraForward,
         FreeCameraBackward,
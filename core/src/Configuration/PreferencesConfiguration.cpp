@@ -20,6 +20,7 @@ namespace IWXMVM
         Configuration::ReadValueInto<float>(j, NODE_ORBIT_ROTATION_SPEED, orbitRotationSpeed);
         Configuration::ReadValueInto<float>(j, NODE_ORBIT_MOVE_SPEED, orbitMoveSpeed);
         Configuration::ReadValueInto<float>(j, NODE_ORBIT_ZOOM_SPEED, orbitZoomSpeed);
+        Configuration::ReadValueInto<int32_t>(j, NODE_UNDO_HISTORY_MEMORY_BUDGET, undoHistoryMemoryBudget);
         Configuration::ReadValueInto<std::filesystem::path>(j, NODE_CAPTURE_OUTPUT_DIRECTORY, captureOutputDirectory);
         Configuration::ReadValueInto<std::vector<std::filesystem::path>>(j, NODE_ADDITIONAL_DEMO_SEARCH_DIRECTORIES,
                                                                          additionalDemoSearchDirectories);
@@ -33,6 +34,7 @@ namespace IWXMVM
         j[NODE_ORBIT_ROTATION_SPEED] = orbitRotationSpeed;
         j[NODE_ORBIT_MOVE_SPEED] = orbitMoveSpeed;
         j[NODE_ORBIT_ZOOM_SPEED] = orbitZoomSpeed;
+        j[NODE_UNDO_HISTORY_MEMORY_BUDGET] = undoHistoryMemoryBudget;
         j[NODE_CAPTURE_OUTPUT_DIRECTORY] = captureOutputDirectory;
         
         j[NODE_ADDITIONAL_DEMO_SEARCH_DIRECTORIES] = nlohmann::json::array();
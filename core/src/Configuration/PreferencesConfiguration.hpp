@@ -28,6 +28,8 @@ namespace IWXMVM
         float orbitMoveSpeed = 0.3f;
         float orbitZoomSpeed = 0.8f;
 
+        int32_t undoHistoryMemoryBudget = 64;  // in megabytes
+
         std::filesystem::path captureOutputDirectory = std::filesystem::path();
 
         std::vector<std::filesystem::path> additionalDemoSearchDirectories;  // Directories added by the user, to be searched
@@ -41,6 +43,7 @@ namespace IWXMVM
         const std::string_view NODE_ORBIT_ROTATION_SPEED = "orbitRotationSpeed";
         const std::string_view NODE_ORBIT_MOVE_SPEED = "orbitMoveSpeed";
         const std::string_view NODE_ORBIT_ZOOM_SPEED = "orbitZoomSpeed";
+        const std::string_view NODE_UNDO_HISTORY_MEMORY_BUDGET = "undoHistoryMemoryBudget";
         const std::string_view NODE_CAPTURE_OUTPUT_DIRECTORY = "captureOutputDirectory";
         const std::string_view NODE_ADDITIONAL_DEMO_SEARCH_DIRECTORIES = "additionalDemoSearchDirectories";
 
@@ -4,9 +4,11 @@
 #include "MinHook.h"
 
 #include "Components/CaptureManager.hpp"
+#include "Components/Playback.hpp"
 #include "Events.hpp"
 #include "Graphics/Graphics.hpp"
 #include "Utilities/PathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 #include "Mod.hpp"
 #include "UI/UIManager.hpp"
 #include "Utilities/HookManager.hpp"
@@ -169,6 +171,8 @@ namespace IWXMVM::D3D9
             return EndScene(pDevice);
         }
 
+        Profiler::NewFrame();
+
         if (!UI::UIManager::Get().IsInitialized())
         {
             device = pDevice;
@@ -203,7 +207,8 @@ namespace IWXMVM::D3D9
             }
         }
 
-        if (Mod::GetGameInterface()->GetGameState() == Types::GameState::InDemo)
+        if (Mod::GetGameInterface()->GetGameState() == Types::GameState::InDemo &&
+            !Components::Playback::IsFastSeeking())
         {
             GFX::GraphicsManager::Get().Render();
         }
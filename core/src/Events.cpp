@@ -1,20 +1,139 @@
 #include "StdInclude.hpp"
 #include "Events.hpp"
 
+#include "Utilities/Profiler.hpp"
+
 namespace IWXMVM::Events
 {
-    std::map<EventType, std::vector<std::function<void()>>> listeners;
+    constexpr std::size_t MAX_LISTENERS_PER_EVENT = 16;
+
+    struct Listener
+    {
+        Delegate delegate;
+        uint32_t id = 0;
+        int32_t priority = 0;
+        std::source_location location;
+        const char* fileName = nullptr;  // names the listener's profiler zone
+
+        float lastMilliseconds = 0.0f;
+        float maxMilliseconds = 0.0f;
+        uint64_t callCount = 0;
+    };
+
+    struct ListenerList
+    {
+        std::array<Listener, MAX_LISTENERS_PER_EVENT> listeners;
+        std::size_t count = 0;
+    };
+
+    std::array<ListenerList, magic_enum::enum_count<EventType>()> listenerLists;
+    uint32_t nextListenerId = 1;
+
+    ListenerList& GetListenerList(const EventType eventType)
+    {
+        return listenerLists[static_cast<std::size_t>(eventType)];
+    }
+
+    Listener* FindListener(ListenerList& list, const uint32_t id, const std::size_t expectedIndex)
+    {
+        // listeners only move when another one is added or removed during a call, so the index is almost always right
+        if (expectedIndex < list.count && list.listeners[expectedIndex].id == id)
+            return &list.listeners[expectedIndex];
+
+        for (std::size_t i = 0; i < list.count; i++)
+        {
+            if (list.listeners[i].id == id)
+                return &list.listeners[i];
+        }
+        return nullptr;
+    }
+
+    ListenerHandle AddListener(const EventType eventType, const Delegate delegate, const int32_t priority,
+                               const std::source_location& location)
+    {
+        auto& list = GetListenerList(eventType);
+        if (list.count == list.listeners.size())
+        {
+            LOG_ERROR("Cannot register more than {} listeners for {}", MAX_LISTENERS_PER_EVENT,
+                      magic_enum::enum_name(eventType));
+            return {eventType, 0};
+        }
+
+        const auto begin = list.listeners.begin();
+        const auto position = std::find_if(begin, begin + list.count,
+                                           [priority](const Listener& l) { return l.priority < priority; });
+        std::move_backward(position, begin + list.count, begin + list.count + 1);
+
+        const auto fileName = std::string_view(location.file_name());
+        const auto separator = fileName.find_last_of("/\\");
+
+        *position = Listener{delegate, nextListenerId++, priority, location,
+                             location.file_name() + (separator != std::string_view::npos ? separator + 1 : 0)};
+        list.count++;
+
+        return {eventType, position->id};
+    }
+
+    void RemoveListener(const ListenerHandle handle)
+    {
+        auto& list = GetListenerList(handle.eventType);
+        const auto listener = FindListener(list, handle.id, 0);
+        if (listener == nullptr)
+            return;
 
-    void Invoke(const EventType eventType)
+        std::move(listener + 1, list.listeners.data() + list.count, listener);
+        list.listeners[--list.count] = Listener{};
+    }
+
+    void InvokeListeners(const EventType eventType, const void* payload)
     {
-        for (const auto& function : listeners[eventType])
+        PROFILE_ZONE(magic_enum::enum_name(eventType).data());
+
+        auto& list = GetListenerList(eventType);
+
+        // listeners may add or remove listeners, so the ids are copied first and looked up again for every call
+        std::array<uint32_t, MAX_LISTENERS_PER_EVENT> ids;
+        const auto count = list.count;
+        for (std::size_t i = 0; i < count; i++)
+            ids[i] = list.listeners[i].id;
+
+        for (std::size_t i = 0; i < count; i++)
         {
-            function();
+            const auto listener = FindListener(list, ids[i], i);
+            if (listener == nullptr)
+                continue;
+
+            // the timings are taken from the listener's profiler zone, so that it's only measured once
+            const auto delegate = listener->delegate;
+            uint64_t elapsedTicks = 0;
+            {
+                PROFILE_ZONE(listener->fileName, listener->location.line(), &elapsedTicks);
+                delegate(payload);
+            }
+
+            if (const auto calledListener = FindListener(list, ids[i], i); calledListener != nullptr)
+            {
+                calledListener->lastMilliseconds = static_cast<float>(Profiler::TicksToMilliseconds(elapsedTicks));
+                calledListener->maxMilliseconds =
+                    std::max(calledListener->maxMilliseconds, calledListener->lastMilliseconds);
+                calledListener->callCount++;
+            }
         }
     }
 
-    void RegisterListener(const EventType eventType, const std::function<void()> function)
+    std::vector<ListenerInfo> GetListenerInfo()
     {
-        listeners[eventType].push_back(function);
+        std::vector<ListenerInfo> info;
+        for (std::size_t i = 0; i < listenerLists.size(); i++)
+        {
+            const auto& list = listenerLists[i];
+            for (std::size_t j = 0; j < list.count; j++)
+            {
+                const auto& listener = list.listeners[j];
+                info.push_back({static_cast<EventType>(i), listener.priority, listener.location,
+                                listener.lastMilliseconds, listener.maxMilliseconds, listener.callCount});
+            }
+        }
+        return info;
     }
-}  // namespace IWXMVM::Events
\ No newline at end of file
+}  // namespace IWXMVM::Events
@@ -12,9 +12,136 @@ namespace IWXMVM
         OnRenderGameView,
     };
 
+    // Payload of OnDemoBoundsDetermined, in timeline ticks
+    struct DemoBounds
+    {
+        uint32_t startTick;
+        uint32_t endTick;
+    };
+
+    // Events that carry data declare its type here, Invoke<eventType> then requires a payload of that type
+    template <EventType eventType>
+    struct EventPayload
+    {
+        using Type = std::monostate;
+    };
+
+    template <>
+    struct EventPayload<EventType::OnDemoBoundsDetermined>
+    {
+        using Type = DemoBounds;
+    };
+
     namespace Events
     {
-        void Invoke(EventType eventType);
-        void RegisterListener(EventType eventType, std::function<void()> function);
+        // Type-erased listener that keeps the callable inline, so registering and invoking never allocate. Only
+        // lambdas with a few pointer-sized captures and plain functions fit.
+        class Delegate
+        {
+           public:
+            static constexpr std::size_t STORAGE_SIZE = 4 * sizeof(void*);
+
+            Delegate() = default;
+
+            template <typename Payload, typename Function>
+            static Delegate Create(Function function)
+            {
+                static_assert(sizeof(Function) <= STORAGE_SIZE, "Listener captures too much state");
+                static_assert(alignof(Function) <= alignof(std::max_align_t));
+                static_assert(std::is_trivially_copyable_v<Function> && std::is_trivially_destructible_v<Function>,
+                              "Listeners may only capture pointers and references");
+
+                Delegate delegate;
+                new (delegate.storage.data()) Function(function);
+                delegate.invoke = [](const std::byte* storage, const void* payload) {
+                    const auto& function = *std::launder(reinterpret_cast<const Function*>(storage));
+                    if constexpr (std::is_invocable_v<const Function&>)
+                    {
+                        function();
+                    }
+                    else
+                    {
+                        static_assert(std::is_invocable_v<const Function&, const Payload&>,
+                                      "Listener must take no arguments or the event's payload");
+                        assert(payload != nullptr);
+                        function(*static_cast<const Payload*>(payload));
+                    }
+                };
+                return delegate;
+            }
+
+            void operator()(const void* payload) const
+            {
+                invoke(storage.data(), payload);
+            }
+
+            explicit operator bool() const
+            {
+                return invoke != nullptr;
+            }
+
+           private:
+            alignas(std::max_align_t) std::array<std::byte, STORAGE_SIZE> storage{};
+            void (*invoke)(const std::byte* storage, const void* payload) = nullptr;
+        };
+
+        struct ListenerHandle
+        {
+            EventType eventType = EventType::OnFrame;
+            uint32_t id = 0;  // 0 if the listener couldn't be registered
+        };
+
+        struct ListenerInfo
+        {
+            EventType eventType;
+            int32_t priority;
+            std::source_location location;  // where the listener was registered
+            float lastMilliseconds;  // timings are 0 if the profiler is compiled out
+            float maxMilliseconds;
+            uint64_t callCount;
+        };
+
+        // Listeners with a higher priority are called first, listeners with the same priority in registration order
+        ListenerHandle AddListener(EventType eventType, Delegate delegate, int32_t priority,
+                                   const std::source_location& location);
+        void RemoveListener(ListenerHandle handle);
+
+        // Calls the listeners with a payload of the event's type, or nullptr; use Invoke, which checks that
+        void InvokeListeners(EventType eventType, const void* payload);
+
+        template <EventType eventType>
+        void Invoke()
+        {
+            static_assert(std::is_same_v<typename EventPayload<eventType>::Type, std::monostate>,
+                          "This event has a payload");
+            InvokeListeners(eventType, nullptr);
+        }
+
+        template <EventType eventType>
+        void Invoke(const typename EventPayload<eventType>::Type& payload)
+        {
+            static_assert(!std::is_same_v<typename EventPayload<eventType>::Type, std::monostate>,
+                          "This event has no payload");
+            InvokeListeners(eventType, &payload);
+        }
+
+        template <typename Function>
+        ListenerHandle RegisterListener(EventType eventType, Function function, int32_t priority = 0,
+                                        const std::source_location& location = std::source_location::current())
+        {
+            return AddListener(eventType, Delegate::Create<std::monostate>(function), priority, location);
+        }
+
+        // Listeners registered this way may take the event's payload as a const reference
+        template <EventType eventType, typename Function>
+        ListenerHandle RegisterListener(Function function, int32_t priority = 0,
+                                        const std::source_location& location = std::source_location::current())
+        {
+            using Payload = typename EventPayload<eventType>::Type;
+            return AddListener(eventType, Delegate::Create<Payload>(function), priority, location);
+        }
+
+        // For the debug panel, the timings are those of the most recent calls
+        std::vector<ListenerInfo> GetListenerInfo();
     }  // namespace Events
-}  // namespace IWXMVM
\ No newline at end of file
+}  // namespace IWXMVM
@@ -71,6 +71,15 @@ namespace IWXMVM
         // perhaps dvars shouldnt be exposed to core at all?
         virtual std::optional<Types::Dvar> GetDvar(const std::string_view name) = 0;
 
+        // Only looks the dvar up by name until it is found, for dvars that are used every frame. Dvars keep their
+        // address once registered, even when the game registers them again.
+        std::optional<Types::Dvar> GetCachedDvar(Types::DvarHandle& handle)
+        {
+            if (!handle.dvar.has_value())
+                handle.dvar = GetDvar(handle.name);
+            return handle.dvar;
+        }
+
         virtual void SetFov(float fov) = 0;
 
         virtual Types::Sun GetSun() = 0;
@@ -9,6 +9,8 @@
 #include "Mod.hpp"
 #include "Types/Vertex.hpp"
 #include "Utilities/MathUtils.hpp"
+#include "Utilities/MeshUtils.hpp"
+#include "Utilities/Profiler.hpp"
 
 INCBIN_EXTERN(VERTEX_SHADER);
 INCBIN_EXTERN(PIXEL_SHADER);
@@ -241,6 +243,8 @@ namespace IWXMVM::GFX
         return view;
     }
 
+    Types::DvarHandle znearDvar("r_znear");
+
     glm::mat4 GetProjectionMatrix()
     {
         const auto& camera = Components::CameraManager::Get().GetActiveCamera();
@@ -249,7 +253,7 @@ namespace IWXMVM::GFX
         const auto tanHalfFovX = glm::tan(glm::radians(camera->GetFov()) * 0.5f);
         const auto tanHalfFovY = tanHalfFovX * (1.0f / aspectRatio);
         const auto fovY = glm::atan(tanHalfFovY) * 2.0f;
-        const auto znear = Mod::GetGameInterface()->GetDvar("r_znear").value().value->floating_point;
+        const auto znear = Mod::GetGameInterface()->GetCachedDvar(znearDvar).value().value->floating_point;
 
         return glm::perspectiveLH_ZO(fovY, aspectRatio, znear, 100000.0f);
     }
@@ -353,29 +357,14 @@ namespace IWXMVM::GFX
 
     bool GraphicsManager::MouseIntersects(ImVec2 mousePos, Mesh& mesh, glm::mat4 model)
     {
+        PROFILE_FUNCTION();
+
         auto& camera = Components::CameraManager::Get().GetActiveCamera();
         const auto view = GetViewMatrix();
         const auto projection = GetProjectionMatrix();
         const auto mouseRayDirection = GetMouseRay(mousePos, projection, view);
 
-        for (size_t i = 0; i < mesh.indices.size(); i += 3)
-        {
-            const auto i1 = mesh.indices[i];
-            const auto i2 = mesh.indices[i+1];
-            const auto i3 = mesh.indices[i+2];
-            const auto a = glm::vec3(model * glm::vec4(mesh.vertices[i1].pos, 1.0f));
-            const auto b = glm::vec3(model * glm::vec4(mesh.vertices[i2].pos, 1.0f));
-            const auto c = glm::vec3(model * glm::vec4(mesh.vertices[i3].pos, 1.0f));
-            
-            glm::vec2 baryPosition;
-            float distance = 0;
-            if (glm::intersectRayTriangle(camera->GetPosition(), glm::normalize(mouseRayDirection), a, b, c,
-                                          baryPosition, distance))
-            {
-                return true;
-            }
-        }
-        return false;
+        return MeshUtils::IntersectsRay(mesh.vertices, mesh.indices, model, camera->GetPosition(), mouseRayDirection);
     }
 
     bool GraphicsManager::MouseIntersectsSphereAt(ImVec2 mousePos, glm::vec3 pos, float radius)
@@ -754,6 +743,8 @@ namespace IWXMVM::GFX
 
     void GraphicsManager::Render()
     {
+        PROFILE_FUNCTION();
+
         if (ImGui::GetMainViewport()->Size.x == 0.0f || ImGui::GetMainViewport()->Size.y == 0.0f)
         {
             return;
@@ -841,6 +832,7 @@ namespace IWXMVM::GFX
                 {
                    selectedNodeId = node.id;
                    gizmoMode = GizmoMode::TranslateLocal;
+                   keyframeManager.BreakModificationCoalescing();
                 }
 
                 if (mouseIntersects && selectedNodeId == node.id && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
@@ -850,6 +842,7 @@ namespace IWXMVM::GFX
 
                 if (selectedNodeId == node.id)
                 {
+                    const auto previousValue = node.value;
                     switch (gizmoMode)
                     {
                         case TranslateGlobal:
@@ -862,6 +855,18 @@ namespace IWXMVM::GFX
                             DrawRotationGizmo(node.value.cameraData.rotation, translate);
                             break;
                     }
+
+                    if (node.value.cameraData.position != previousValue.cameraData.position ||
+                        node.value.cameraData.rotation != previousValue.cameraData.rotation)
+                    {
+                        // the whole drag becomes one undo step, which is also what saves it
+                        if (!keyframeManager.IsKeyframeValueBeingModified(node))
+                            keyframeManager.BeginModifyingKeyframeValue(node, previousValue);
+                        keyframeManager.MarkKeyframesChanged(property);
+                    }
+
+                    if (!heldAxis.has_value() && keyframeManager.IsKeyframeValueBeingModified(node))
+                        keyframeManager.EndModifyingKeyframeValue(property, node);
                 }
             }
 
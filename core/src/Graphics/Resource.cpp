@@ -4,25 +4,8 @@
 
 #include "D3D9.hpp"
 #include "Types/Vertex.hpp"
-
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
-
-#define TINYOBJLOADER_IMPLEMENTATION
-#include "tiny_obj_loader.h"
-
-namespace std
-{
-    template <>
-    struct hash<IWXMVM::Types::Vertex>
-    {
-        size_t operator()(IWXMVM::Types::Vertex const& vertex) const
-        {
-            return ((hash<glm::vec3>()(vertex.pos) ^ (hash<glm::vec3>()(vertex.normal) << 1)) >> 1) ^
-                   (hash<D3DCOLOR>()(vertex.col) << 1);
-        }
-    };
-}  // namespace std
+#include "Utilities/MeshUtils.hpp"
+#include "Utilities/Profiler.hpp"
 
 namespace IWXMVM::GFX
 {
@@ -31,59 +14,23 @@ namespace IWXMVM::GFX
 
     Mesh::Mesh(const uint8_t data[], uint32_t size)
     {
-        std::string_view dataStringView(reinterpret_cast<const char*>(data), size);
-        std::string dataString(dataStringView);
-
-        tinyobj::ObjReader reader;
+        PROFILE_FUNCTION();
 
-        if (!reader.ParseFromString(dataString, ""))
+        std::string warning;
+        std::string error;
+        if (!MeshUtils::LoadObj(std::string_view(reinterpret_cast<const char*>(data), size), vertices, indices,
+                                warning, error))
         {
-            if (!reader.Error().empty())
+            if (!error.empty())
             {
-                LOG_ERROR("TinyObjReader: {}", reader.Error());
+                LOG_ERROR("TinyObjReader: {}", error);
             }
             return;
         }
 
-        if (!reader.Warning().empty())
+        if (!warning.empty())
         {
-            LOG_WARN("TinyObjReader: {}", reader.Warning());
-        }
-
-        auto& attrib = reader.GetAttrib();
-        auto& shapes = reader.GetShapes();
-
-        vertices.reserve(attrib.vertices.size() / 3);
-
-        // Loop over shapes
-        std::unordered_map<Types::Vertex, std::uint32_t> uniqueVertices;
-        for (const auto& shape : shapes)
-        {
-            for (const auto& index : shape.mesh.indices)
-            {
-                Types::Vertex vertex = {};
-                vertex.pos = {
-                    attrib.vertices[index.vertex_index * 3 + 0],
-                    attrib.vertices[index.vertex_index * 3 + 1],
-                    attrib.vertices[index.vertex_index * 3 + 2],
-                };
-                vertex.normal = {
-                    attrib.normals[index.normal_index * 3 + 0],
-                    attrib.normals[index.normal_index * 3 + 1],
-                    attrib.normals[index.normal_index * 3 + 2],
-                };
-                vertex.col = D3DCOLOR_COLORVALUE(attrib.colors[index.vertex_index * 3 + 0],
-                                                 attrib.colors[index.vertex_index * 3 + 1],
-                                                 attrib.colors[index.vertex_index * 3 + 2], 1.0f);
-                
-                if (uniqueVertices.count(vertex) == 0)
-                {
-                    uniqueVertices[vertex] = static_cast<std::uint32_t>(vertices.size());
-                    vertices.push_back(vertex);
-                }
-
-                indices.push_back(uniqueVertices[vertex]);
-            }
+            LOG_WARN("TinyObjReader: {}", warning);
         }
     }
 
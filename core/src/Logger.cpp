@@ -6,22 +6,85 @@ namespace IWXMVM
     constexpr auto LOGGER_NAME = "IWXMVM";
     constexpr auto LOG_FILE = "IWXMVM.log";
 
+    // messages are formatted on the calling thread and written by a background thread; if it falls behind, the oldest
+    // queued messages are dropped instead of blocking the game
+    constexpr std::size_t LOG_QUEUE_SIZE = 8192;
+    constexpr auto LOG_FLUSH_INTERVAL = std::chrono::seconds(1);
+    constexpr auto DUPLICATE_WINDOW = std::chrono::seconds(5);
+
     std::shared_ptr<spdlog::logger> Logger::internalLogger;
 
+    LPTOP_LEVEL_EXCEPTION_FILTER previousExceptionFilter = nullptr;
+    std::atomic_bool isShutDown = false;
+
+    LONG WINAPI FlushOnUnhandledException(EXCEPTION_POINTERS* exceptionInfo)
+    {
+        LOG_CRITICAL("Unhandled exception {:#x} at {}", exceptionInfo->ExceptionRecord->ExceptionCode,
+                     exceptionInfo->ExceptionRecord->ExceptionAddress);
+
+        const auto previousFilter = previousExceptionFilter;
+        Logger::Shutdown();
+        return previousFilter != nullptr ? previousFilter(exceptionInfo) : EXCEPTION_CONTINUE_SEARCH;
+    }
+
+    bool Logger::RateLimit::Acquire(spdlog::level::level_enum level, const char* file, int line)
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        const auto windowTicks = std::chrono::duration_cast<std::chrono::steady_clock::duration>(WINDOW_LENGTH).count();
+
+        auto start = windowStart.load(std::memory_order_relaxed);
+        if (now - start >= windowTicks && windowStart.compare_exchange_strong(start, now))
+        {
+            messageCount.store(0, std::memory_order_relaxed);
+            if (const auto suppressed = suppressedCount.exchange(0); suppressed > 0)
+                internalLogger->log(level, "Suppressed {} messages from {}:{}", suppressed, file, line);
+        }
+
+        if (messageCount.fetch_add(1, std::memory_order_relaxed) < MAX_MESSAGES_PER_WINDOW)
+            return true;
+
+        suppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
     void Logger::Initialize()
     {
-        std::vector<spdlog::sink_ptr> sinks;
-        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>(spdlog::color_mode::always));
-        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(LOG_FILE, (size_t)5e6, 1));
-        internalLogger = std::make_shared<spdlog::logger>(LOGGER_NAME, sinks.begin(), sinks.end());
+        // identical consecutive messages are collapsed on the background thread
+        auto duplicateFilter = std::make_shared<spdlog::sinks::dup_filter_sink_mt>(DUPLICATE_WINDOW);
+        duplicateFilter->add_sink(std::make_shared<spdlog::sinks::stdout_color_sink_mt>(spdlog::color_mode::always));
+        duplicateFilter->add_sink(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(LOG_FILE, (size_t)5e6, 1));
+
+        spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+        internalLogger = std::make_shared<spdlog::async_logger>(LOGGER_NAME, duplicateFilter, spdlog::thread_pool(),
+                                                                spdlog::async_overflow_policy::overrun_oldest);
         internalLogger->set_pattern("[%d.%m.%C %H:%M:%S] [%n] [%^%l%$] %v");
-        internalLogger->flush_on(spdlog::level::trace);
+        internalLogger->flush_on(spdlog::level::warn);
         internalLogger->set_level(spdlog::level::debug);
+
+        // registered so the periodic flush reaches it
+        spdlog::register_logger(internalLogger);
+        spdlog::flush_every(LOG_FLUSH_INTERVAL);
+
+        previousExceptionFilter = ::SetUnhandledExceptionFilter(FlushOnUnhandledException);
+
         LOG_INFO("Initialized Logger");
     }
 
-    std::shared_ptr<spdlog::logger> Logger::GetInternalLogger()
+    void Logger::Shutdown()
+    {
+        if (isShutDown.exchange(true))
+            return;
+
+        ::SetUnhandledExceptionFilter(previousExceptionFilter);
+        previousExceptionFilter = nullptr;
+
+        // destroys the thread pool, which writes out everything that is still queued before its thread exits
+        internalLogger->flush();
+        spdlog::shutdown();
+    }
+
+    const std::shared_ptr<spdlog::logger>& Logger::GetInternalLogger()
     {
         return internalLogger;
     }
-}  // namespace IWXMVM
\ No newline at end of file
+}  // namespace IWXMVM
@@ -2,15 +2,29 @@
 
 #pragma warning(push, 0)
 #include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/dup_filter_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/sinks/rotating_file_sink.h"
 #pragma warning(pop)
 
-#define LOG_INFO(...) Logger::GetInternalLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...) Logger::GetInternalLogger()->warn(__VA_ARGS__)
-#define LOG_DEBUG(...) Logger::GetInternalLogger()->debug(__VA_ARGS__)
-#define LOG_ERROR(...) Logger::GetInternalLogger()->error(__VA_ARGS__)
-#define LOG_CRITICAL(...) Logger::GetInternalLogger()->critical(__VA_ARGS__)
+// Every call site is rate limited on its own, the check happens before the message is formatted
+#define LOG_WITH_LEVEL(level, ...)                                                   \
+    do                                                                               \
+    {                                                                                \
+        static ::IWXMVM::Logger::RateLimit logRateLimit;                             \
+        if (::IWXMVM::Logger::GetInternalLogger()->should_log(level) &&              \
+            logRateLimit.Acquire(level, __FILE__, __LINE__))                         \
+        {                                                                            \
+            ::IWXMVM::Logger::GetInternalLogger()->log(level, __VA_ARGS__);          \
+        }                                                                            \
+    } while (false)
+
+#define LOG_INFO(...) LOG_WITH_LEVEL(spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...) LOG_WITH_LEVEL(spdlog::level::warn, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_WITH_LEVEL(spdlog::level::debug, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_WITH_LEVEL(spdlog::level::err, __VA_ARGS__)
+#define LOG_CRITICAL(...) ::IWXMVM::Logger::GetInternalLogger()->critical(__VA_ARGS__)
 
 namespace IWXMVM
 {
@@ -18,10 +32,29 @@ namespace IWXMVM
     class Logger
     {
        public:
+        // Allows a burst of messages per call site in every window, the rest is counted and reported afterwards
+        class RateLimit
+        {
+           public:
+            static constexpr uint32_t MAX_MESSAGES_PER_WINDOW = 20;
+            static constexpr std::chrono::seconds WINDOW_LENGTH{1};
+
+            bool Acquire(spdlog::level::level_enum level, const char* file, int line);
+
+           private:
+            std::atomic<int64_t> windowStart = 0;
+            std::atomic<uint32_t> messageCount = 0;
+            std::atomic<uint32_t> suppressedCount = 0;
+        };
+
         static void Initialize();
-        static std::shared_ptr<spdlog::logger> GetInternalLogger();
+
+        // Writes out all queued messages, called when ejecting and on unhandled exceptions
+        static void Shutdown();
+
+        static const std::shared_ptr<spdlog::logger>& GetInternalLogger();
 
        private:
         static std::shared_ptr<spdlog::logger> internalLogger;
     };
-}  // namespace IWXMVM
\ No newline at end of file
+}  // namespace IWXMVM
@@ -11,6 +11,8 @@
 #include "UI/UIManager.hpp"
 #include "Configuration/Configuration.hpp"
 #include "Graphics/Graphics.hpp"
+#include "Components/DemoReadTrace.hpp"
+#include "Components/KeyframeJournal.hpp"
 
 namespace IWXMVM
 {
@@ -54,6 +56,7 @@ namespace IWXMVM
             Components::CampathManager::Get().Initialize();
             Components::KeyframeManager::Get().Initialize();
             Components::Rewinding::Initialize();
+            Components::DemoReadTrace::Initialize();
             Components::Rendering::Initialize();
 
             LOG_DEBUG("Installing game hooks and patches...");
@@ -75,7 +78,10 @@ namespace IWXMVM
             LOG_DEBUG("Released UI and graphic resources");
             UI::UIManager::Get().ShutdownImGui();
             LOG_DEBUG("ImGui successfully shutdown");
+            Components::KeyframeJournal::Get().Shutdown();
+            LOG_DEBUG("Flushed keyframe journal");
 
+            Logger::Shutdown();
             WindowsConsole::Close();
             ::FreeLibraryAndExitThread(GetCurrentModule(), 0);
         }
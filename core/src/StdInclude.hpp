@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cstdint>
 #include <cstdio>
 #include <cwctype>
@@ -21,6 +22,18 @@
 #include <variant>
 #include <stack>
 #include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <execution>
+#include <charconv>
+#include <source_location>
+
+#include <emmintrin.h>
+#include <intrin.h>
 
 #include <initguid.h>
 #include <d3d9.h>
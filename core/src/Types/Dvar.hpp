@@ -22,4 +22,15 @@ namespace IWXMVM::Types
         }* value;
     };
 
+    // See GameInterface::GetCachedDvar
+    struct DvarHandle
+    {
+        explicit DvarHandle(std::string_view name) : name(name)
+        {
+        }
+
+        std::string_view name;
+        std::optional<Dvar> dvar;
+    };
+
 }  // namespace IWXMVM::Types
\ No newline at end of file
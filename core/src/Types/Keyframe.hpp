@@ -108,6 +108,66 @@ namespace IWXMVM::Types
 		}
     };
 
+    enum class KeyframeInterpolationMode
+    {
+        Hold,
+        Linear,
+        Cubic,
+        Bezier,
+        TCB,
+    };
+
+    // Describes the curve from a keyframe up to the next one
+    struct KeyframeInterpolation
+    {
+        static constexpr std::size_t MAX_VALUE_COUNT = sizeof(KeyframeValue) / sizeof(float);
+
+        // Only used by the Bezier and TCB modes
+        struct Parameters
+        {
+            // Bezier handles, as the slope of each value (in units per tick) when entering and leaving the keyframe
+            std::array<float, MAX_VALUE_COUNT> inTangents;
+            std::array<float, MAX_VALUE_COUNT> outTangents;
+
+            // Kochanek-Bartels parameters
+            float tension;
+            float continuity;
+            float bias;
+
+            bool operator==(const Parameters& other) const = default;
+        };
+
+        KeyframeInterpolationMode mode = KeyframeInterpolationMode::Cubic;
+
+        // Most keyframes never get parameters, so they are kept out of line and only allocated once they are edited.
+        // Copies of a keyframe (e.g. in the undo history) share them until one of the copies is edited.
+        const Parameters& GetParameters() const
+        {
+            static constexpr Parameters DEFAULT_PARAMETERS{};
+            return parameters ? *parameters : DEFAULT_PARAMETERS;
+        }
+
+        Parameters& EditParameters()
+        {
+            if (!parameters || parameters.use_count() > 1)
+                parameters = std::make_shared<Parameters>(GetParameters());
+            return *parameters;
+        }
+
+        bool HasParameters() const
+        {
+            return parameters != nullptr;
+        }
+
+        bool operator==(const KeyframeInterpolation& other) const
+        {
+            return mode == other.mode && GetParameters() == other.GetParameters();
+        }
+
+       private:
+        std::shared_ptr<Parameters> parameters;
+    };
+
     struct Keyframe
     {
         std::reference_wrapper<const KeyframeableProperty> property;
@@ -115,6 +175,7 @@ namespace IWXMVM::Types
         std::int32_t id;
         std::uint32_t tick;
         KeyframeValue value;
+        KeyframeInterpolation interpolation;
 
         Keyframe(const KeyframeableProperty& property, std::uint32_t tick, KeyframeValue value)
             : id(nextId++), property(property), tick(tick), value(value)
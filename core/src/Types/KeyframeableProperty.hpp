@@ -19,7 +19,8 @@ namespace IWXMVM::Types
         DepthOfFieldNearBlur,
         DepthOfFieldNearStart,
         DepthOfFieldNearEnd,
-        DepthOfFieldBias
+        DepthOfFieldBias,
+        PlaybackSpeed
     };
 
     enum class KeyframeValueType
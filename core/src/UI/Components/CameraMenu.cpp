@@ -175,8 +175,10 @@ namespace IWXMVM::UI
             auto& config = InputConfiguration::Get();
 
             ImGui::TextWrapped(
-                "No campath nodes set! To create a dollycam campath, go into Free Camera and press %s to place nodes.",
-                ImGui::GetKeyName(config.GetBoundKey(Action::DollyAddNode)));
+                "No campath nodes set! To create a dollycam campath, go into Free Camera and press %s to place nodes, "
+                "or press %s to record the camera while the demo plays.",
+                ImGui::GetKeyName(config.GetBoundKey(Action::DollyAddNode)),
+                ImGui::GetKeyName(config.GetBoundKey(Action::DollyRecordPath)));
             return;
         }
 
@@ -192,6 +194,16 @@ namespace IWXMVM::UI
         ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * (1.0f - columnPercent) - ImGui::GetStyle().WindowPadding.x);
         ImGui::Text("%s", campathNodes.size() < 4 ? "Linear" : "Cubic");
 
+        auto dollyCamera = static_cast<Components::DollyCamera*>(
+            Components::CameraManager::Get().GetCamera(Components::Camera::Mode::Dolly).get());
+
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("Constant Speed");
+        ImGui::SameLine();
+        ImGui::SetCursorPosX(ImGui::GetWindowWidth() * columnPercent);
+        ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * (1.0f - columnPercent) - ImGui::GetStyle().WindowPadding.x);
+        ImGui::Checkbox("##dollyCameraConstantSpeed", &dollyCamera->UseConstantSpeed());
+
         ImGui::Dummy(ImVec2(0, 5));
 
         if (campathNodes.size() < 4)
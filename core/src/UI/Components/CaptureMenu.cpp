@@ -8,6 +8,7 @@
 #include "UI/UIManager.hpp"
 #include "Components/CaptureManager.hpp"
 #include "Components/CameraManager.hpp"
+#include "Components/Playback.hpp"
 #include "Utilities/PathUtils.hpp"
 #include "Configuration/PreferencesConfiguration.hpp"
 #include "UI/TaskbarProgress.hpp"
@@ -287,12 +288,12 @@ namespace IWXMVM::UI
             ImGui::SetCursorPosX(ImGui::GetWindowWidth() * fieldLayoutPercentage);
             ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * (1 - fieldLayoutPercentage) -
                                     ImGui::GetStyle().WindowPadding.x);
-            if (ImGui::BeginCombo("##captureMenuFramerateCombo", std::to_string(captureSettings.framerate).c_str()))
+            if (ImGui::BeginCombo("##captureMenuFramerateCombo", captureSettings.framerate.ToString().c_str()))
             {
                 for (auto framerate : captureManager.GetSupportedFramerates())
                 {
                     bool isSelected = captureSettings.framerate == framerate;
-                    if (ImGui::Selectable(std::to_string(framerate).c_str(),
+                    if (ImGui::Selectable(framerate.ToString().c_str(),
                                           captureSettings.framerate == framerate))
                     {
                         captureSettings.framerate = framerate;
@@ -399,7 +400,9 @@ namespace IWXMVM::UI
                 ImGui::PopFont();
                 ImGui::Text("Captured %d frames", captureManager.GetCapturedFrameCount());
 
-                auto totalFrames = (captureSettings.endTick - captureSettings.startTick) * (captureSettings.framerate / 1000.0f);
+                auto totalFrames = static_cast<float>(
+                    Playback::GetOutputDuration(captureSettings.startTick, captureSettings.endTick) *
+                    (captureSettings.framerate.ToDouble() / 1000.0));
                 ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImGui::GetColorU32(ImGuiCol_Button));
 
                 if (CaptureManager::Get().MultiPassEnabled())
@@ -2,7 +2,10 @@
 #include "DebugPanel.hpp"
 
 #include "Components/Playback.hpp"
+#include "Events.hpp"
 #include "Utilities/HookManager.hpp"
+#include "Utilities/PathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 #include "UI/UIManager.hpp"
 #include "Mod.hpp"
 
@@ -26,6 +29,10 @@ namespace IWXMVM::UI
             }
             ImGui::Text("Demo Tick: %d", Components::Playback::GetTimelineTick());
             ImGui::Text("Demo End Tick: %d", demoInfo.endTick);
+            if (const auto seekDuration = Components::Playback::GetLastFastSeekDuration(); seekDuration.has_value())
+            {
+                ImGui::Text("Last Seek: %.1f ms", seekDuration.value());
+            }
 
             auto keyframeEditor = UIManager::Get().GetUIComponent<KeyframeEditor>(UI::Component::KeyframeEditor);
             auto [displayStartTick, displayEndTick] = keyframeEditor->GetDisplayTickRange();
@@ -33,12 +40,139 @@ namespace IWXMVM::UI
 
             auto& camera = Components::CameraManager::Get().GetActiveCamera();
             ImGui::Text("Camera: %f %f %f", camera->GetPosition().x, camera->GetPosition().y, camera->GetPosition().z);
+
+            if (ImGui::TreeNode("Event Listeners"))
+            {
+                for (const auto& listener : Events::GetListenerInfo())
+                {
+                    const auto fileName = std::filesystem::path(listener.location.file_name()).filename().string();
+                    ImGui::Text("%s (%d) %s:%d - %.3f ms (max %.3f ms)",
+                                magic_enum::enum_name(listener.eventType).data(), listener.priority, fileName.c_str(),
+                                static_cast<int>(listener.location.line()), listener.lastMilliseconds,
+                                listener.maxMilliseconds);
+                }
+                ImGui::TreePop();
+            }
+
+            if (ImGui::TreeNode("Profiler"))
+            {
+                DrawProfiler();
+                ImGui::TreePop();
+            }
+
+            if (ImGui::TreeNode("Demo Reads"))
+            {
+                DrawDemoReadTrace();
+                ImGui::TreePop();
+            }
+
             if (ImGui::Button("Eject"))
                 Mod::RequestEject();
             ImGui::End();
         }
     }
 
+    void DebugPanel::DrawProfiler()
+    {
+        const auto& frame = Profiler::GetLastFrame();
+        const auto frameTicks = frame.end - frame.start;
+
+        ImGui::Text("Frame: %.2f ms", Profiler::TicksToMilliseconds(frameTicks));
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            Profiler::ExportChromeTrace(std::filesystem::path(PathUtils::GetCurrentGameDirectory()) / "IWXMVM" /
+                                        "profile.json");
+        }
+
+        if (frameTicks == 0)
+            return;
+
+        // every thread gets its own lane, with nested zones below their parents
+        std::vector<std::pair<uint32_t, uint32_t>> lanes;  // thread id, max depth
+        for (const auto& zone : frame.zones)
+        {
+            auto lane =
+                std::find_if(lanes.begin(), lanes.end(), [&](const auto& l) { return l.first == zone.threadId; });
+            if (lane == lanes.end())
+                lanes.emplace_back(zone.threadId, zone.depth);
+            else
+                lane->second = std::max(lane->second, zone.depth);
+        }
+
+        const auto width = 640.0f;
+        const auto rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+        const auto origin = ImGui::GetCursorScreenPos();
+        auto drawList = ImGui::GetWindowDrawList();
+
+        auto laneY = origin.y;
+        for (const auto& [threadId, maxDepth] : lanes)
+        {
+            for (const auto& zone : frame.zones)
+            {
+                if (zone.threadId != threadId)
+                    continue;
+
+                auto GetX = [&](uint64_t ticks) {
+                    const auto offset = std::clamp(ticks, frame.start, frame.end) - frame.start;
+                    return origin.x + width * static_cast<float>(offset) / static_cast<float>(frameTicks);
+                };
+
+                const auto min = ImVec2(GetX(zone.start), laneY + rowHeight * static_cast<float>(zone.depth));
+                const auto max = ImVec2(std::max(GetX(zone.end), min.x + 1.0f), min.y + rowHeight - 1.0f);
+
+                char label[128];
+                if (zone.line != 0)
+                    std::snprintf(label, sizeof(label), "%s:%u", zone.name, zone.line);
+                else
+                    std::snprintf(label, sizeof(label), "%s", zone.name);
+
+                const auto hue = static_cast<float>(std::hash<std::string_view>{}(zone.name) % 360) / 360.0f;
+                drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+                drawList->PushClipRect(min, max, true);
+                drawList->AddText(min + ImVec2(2.0f, 2.0f), IM_COL32_WHITE, label);
+                drawList->PopClipRect();
+
+                if (ImGui::IsMouseHoveringRect(min, max))
+                {
+                    ImGui::SetTooltip("%s\n%.3f ms (thread %u)", label,
+                                      Profiler::TicksToMilliseconds(zone.end - zone.start), threadId);
+                }
+            }
+
+            laneY += rowHeight * static_cast<float>(maxDepth + 1) + 4.0f;
+        }
+
+        ImGui::Dummy(ImVec2(width, laneY - origin.y));
+    }
+
+    void DebugPanel::DrawDemoReadTrace()
+    {
+        using namespace Components;
+
+        if (ImGui::Button(DemoReadTrace::IsRecording() ? "Stop Recording" : "Record"))
+        {
+            if (DemoReadTrace::IsRecording())
+                DemoReadTrace::StopRecording();
+            else
+                DemoReadTrace::StartRecording();
+        }
+
+        ImGui::SameLine();
+        ImGui::BeginDisabled(DemoReadTrace::IsRecording());
+        if (ImGui::Button("Replay"))
+        {
+            lastReplayResult = DemoReadTrace::Replay(DemoReadTrace::GetTracePath());
+        }
+        ImGui::EndDisabled();
+
+        if (lastReplayResult.has_value())
+        {
+            ImGui::Text("%zu reads, %zu seeks, %.2f ms, %zu violations", lastReplayResult->readCount,
+                        lastReplayResult->seekCount, lastReplayResult->milliseconds, lastReplayResult->violationCount);
+        }
+    }
+
     void DebugPanel::Release()
     {
     }
@@ -1,5 +1,6 @@
 #pragma once
 #include "UI/UIComponent.hpp"
+#include "Components/DemoReadTrace.hpp"
 
 namespace IWXMVM::UI
 {
@@ -11,5 +12,10 @@ namespace IWXMVM::UI
 
        private:
         void Initialize() final;
+
+        void DrawProfiler();
+        void DrawDemoReadTrace();
+
+        std::optional<DemoReads::ReplayResult> lastReplayResult;
     };
 }  // namespace IWXMVM::UI
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "Input.hpp"
 #include "Components/Rewinding.hpp"
 #include "Components/CaptureManager.hpp"
+#include "Components/CampathManager.hpp"
 #include "Graphics/Graphics.hpp"
 #include "Configuration/PreferencesConfiguration.hpp"
 
@@ -178,6 +179,11 @@ namespace IWXMVM::UI
 
                     ImGui::SameLine(0, spacing);
                     DrawKeybindEntry(ImGui::GetKeyName(config.GetBoundKey(Action::DollyClearNodes)), "Delete Campath");
+
+                    ImGui::SameLine(0, spacing);
+                    DrawKeybindEntry(ImGui::GetKeyName(config.GetBoundKey(Action::DollyRecordPath)),
+                                     Components::CampathManager::Get().IsRecording() ? "Stop Recording"
+                                                                                     : "Record Campath");
                 }
 
                 ImGui::SameLine(0, spacing * 1.5f);
@@ -421,7 +427,7 @@ namespace IWXMVM::UI
             ImGui::Image((void*)texture, textureSize); 
         }
 
-        Events::Invoke(EventType::OnRenderGameView);
+        Events::Invoke<EventType::OnRenderGameView>();
         if (Mod::GetGameInterface()->GetGameState() == Types::GameState::InDemo)
         {
             DrawGizmoControls();
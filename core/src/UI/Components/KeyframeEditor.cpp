@@ -11,10 +11,13 @@
 #include "Input.hpp"
 #include "Components/KeyframeManager.hpp"
 #include "Components/KeyframeSerializer.hpp"
+#include "Components/KeyframeJournal.hpp"
+#include "Components/CameraTrackImporter.hpp"
 #include "Components/Rewinding.hpp"
 #include "Components/Playback.hpp"
 #include "Events.hpp"
 #include "Utilities/PathUtils.hpp"
+#include "Utilities/KeyframeReduction.hpp"
 
 namespace IWXMVM::UI
 {
@@ -271,8 +274,10 @@ namespace IWXMVM::UI
             if (std::find_if(keyframes.begin(), keyframes.end(), [tick](const auto& k) { return k.tick == tick; }) ==
                 keyframes.end())
             {
-                keyframes.emplace_back(property, tick, Components::KeyframeManager::Get().Interpolate(property, tick));
-                Components::KeyframeManager::Get().SortAndSaveKeyframes(keyframes);
+                auto& keyframeManager = Components::KeyframeManager::Get();
+                keyframeManager.AddKeyframe(property,
+                                            Types::Keyframe(property, tick, keyframeManager.Interpolate(property, tick)));
+                keyframeManager.SortAndSaveKeyframes(keyframes);
             }
         }
 
@@ -440,7 +445,7 @@ namespace IWXMVM::UI
 
             for (auto tick = displayStartTick; tick <= displayEndTick; tick += EVALUATION_DISTANCE)
             {
-                auto value = Components::KeyframeManager::Get().Interpolate(property, keyframes, tick);
+                auto value = EvaluateCurve(property, keyframes, tick);
                 auto position =
                     GetPositionForKeyframe(frame_bb, Types::Keyframe(property, tick, value), displayStartTick,
                                            displayEndTick, valueBoundaries, keyframeValueIndex);
@@ -561,6 +566,55 @@ namespace IWXMVM::UI
                     }
                 }
 
+                ImGui::Text("Interpolation:");
+
+                ImGui::Separator();
+
+                auto interpolation = k.interpolation;
+
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+                if (ImGui::BeginCombo("##interpolationMode", magic_enum::enum_name(interpolation.mode).data()))
+                {
+                    for (auto mode : magic_enum::enum_values<Types::KeyframeInterpolationMode>())
+                    {
+                        if (ImGui::Selectable(magic_enum::enum_name(mode).data(), interpolation.mode == mode))
+                            interpolation.mode = mode;
+                    }
+                    ImGui::EndCombo();
+                }
+
+                // parameters are only allocated for the keyframe once one of them is actually changed
+                auto parameters = interpolation.GetParameters();
+                bool parametersChanged = false;
+
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+                switch (interpolation.mode)
+                {
+                    case Types::KeyframeInterpolationMode::Bezier:
+                        parametersChanged |=
+                            ImGui::DragFloat("In Slope", &parameters.inTangents[keyframeValueIndex], 0.01f);
+                        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+                        parametersChanged |=
+                            ImGui::DragFloat("Out Slope", &parameters.outTangents[keyframeValueIndex], 0.01f);
+                        break;
+                    case Types::KeyframeInterpolationMode::TCB:
+                        parametersChanged |=
+                            ImGui::DragFloat("Tension", &parameters.tension, 0.01f, -1.0f, 1.0f, "%.2f");
+                        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+                        parametersChanged |=
+                            ImGui::DragFloat("Continuity", &parameters.continuity, 0.01f, -1.0f, 1.0f, "%.2f");
+                        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+                        parametersChanged |= ImGui::DragFloat("Bias", &parameters.bias, 0.01f, -1.0f, 1.0f, "%.2f");
+                        break;
+                    default:
+                        break;
+                }
+
+                if (parametersChanged)
+                    interpolation.EditParameters() = parameters;
+
+                Components::KeyframeManager::Get().SetKeyframeInterpolation(property, k, interpolation);
+
                 if (ImGui::IsKeyPressed(ImGuiKey_Enter))
                 {
                     ImGui::CloseCurrentPopup();
@@ -603,9 +657,9 @@ namespace IWXMVM::UI
 
     void KeyframeEditor::Initialize()
     {
-        Events::RegisterListener(EventType::OnDemoBoundsDetermined, [this]() {
-            displayStartTick = 0;
-            displayEndTick = Mod::GetGameInterface()->GetDemoInfo().endTick;
+        Events::RegisterListener<EventType::OnDemoBoundsDetermined>([this](const DemoBounds& bounds) {
+            displayStartTick = bounds.startTick;
+            displayEndTick = bounds.endTick;
 
             LOG_DEBUG("Set initial keyframe editor zoom as {} to {}", displayStartTick, displayEndTick);
         });
@@ -638,12 +692,15 @@ namespace IWXMVM::UI
         auto currentTick = Components::Playback::GetTimelineTick();
         auto [displayStartTick, displayEndTick] = GetDisplayTickRange();
 
+        // the smoothing popup is modal, so the preview can't be edited while it is shown
+        auto& keyframes = smoothingProperty == property.type ? smoothingPreview
+                                                             : Components::KeyframeManager::Get().GetKeyframes(property);
+
         bool result = false;
         for (int i = 0; i < property.GetValueCount(); i++)
         {
-            result = DrawCurveEditorInternal(property, &currentTick, displayStartTick, displayEndTick, width,
-                                             Components::KeyframeManager::Get().GetKeyframes(property), i,
-                                             demoInfo.endTick, Components::Playback::GetFrozenTick()) || result;
+            result = DrawCurveEditorInternal(property, &currentTick, displayStartTick, displayEndTick, width, keyframes,
+                                             i, demoInfo.endTick, Components::Playback::GetFrozenTick()) || result;
         }
         return result;
     }
@@ -727,6 +784,9 @@ namespace IWXMVM::UI
     }
 
     constexpr auto CLEAR_KEYFRAMES_POPUP_LABEL = "Are you sure?##clearKeyframes";
+    constexpr auto KEYFRAME_FILE_FILTER = "Keyframes (*.json)\0*.json\0Binary Keyframes (*.iwxk)\0*.iwxk\0";
+    constexpr auto IMPORT_CAMERA_TRACK_POPUP_LABEL = "Import Camera Track##importCameraTrack";
+    constexpr auto CAMERA_TRACK_FILE_FILTER = "Camera Tracks (*.csv, *.jsonl)\0*.csv;*.jsonl;*.ndjson\0";
     void KeyframeEditor::DrawMiscButtons(ImVec2 padding, bool hasKeyframes)
     {
         ImGui::SetCursorPosY(ImGui::GetWindowHeight() - ImGui::GetFontSize() * 2 - padding.y);
@@ -735,7 +795,7 @@ namespace IWXMVM::UI
             if (ImGui::Button(ICON_FA_FILE_ARROW_DOWN " Export", ImVec2(GetSize().x / 20, 0)))
             {
                 auto path = PathUtils::OpenFileDialog(true, OFN_EXPLORER | OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT,
-                                                      "Keyframes (*.json)\0*.json\0", "json");
+                                                      KEYFRAME_FILE_FILTER, "json");
                 if (path.has_value())
                 {
                     Components::KeyframeSerializer::Write(path.value());
@@ -752,16 +812,285 @@ namespace IWXMVM::UI
         {
             if (ImGui::Button(ICON_FA_FILE_IMPORT " Import", ImVec2(GetSize().x / 20, 0)))
             {
-                auto path = PathUtils::OpenFileDialog(false, OFN_EXPLORER | OFN_FILEMUSTEXIST,
-                                                      "Keyframes (*.json)\0*.json\0", "json");
+                auto path = PathUtils::OpenFileDialog(false, OFN_EXPLORER | OFN_FILEMUSTEXIST, KEYFRAME_FILE_FILTER,
+                                                      "json");
                 if (path.has_value())
                 {
                     Components::KeyframeSerializer::Read(path.value());
+                    Components::KeyframeJournal::Get().Compact();
                     LOG_INFO("Read keyframes from {}", path.value().string());
                     SetDefaultVerticalZoom();     
                 }
             }
         }
+
+        ImGui::SameLine();
+        if (ImGui::Button(ICON_FA_VIDEO " Import Camera Track", ImVec2(GetSize().x / 12, 0)))
+        {
+            ImGui::OpenPopup(IMPORT_CAMERA_TRACK_POPUP_LABEL);
+        }
+    }
+
+    void KeyframeEditor::DrawCameraTrackImportPopup()
+    {
+        if (!ImGui::BeginPopupModal(IMPORT_CAMERA_TRACK_POPUP_LABEL, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+            return;
+
+        auto& settings = cameraTrackImportSettings;
+
+        ImGui::Text("Imports a CSV or JSON lines file into the campath, starting at the current tick");
+
+        auto upAxis = static_cast<int>(settings.upAxis);
+        if (ImGui::Combo("Up Axis", &upAxis, "Z (Game)\0Y\0"))
+            settings.upAxis = static_cast<Components::CameraTrackImporter::UpAxis>(upAxis);
+        if (settings.upAxis == Components::CameraTrackImporter::UpAxis::Y)
+            ImGui::TextDisabled("Rotations of Y-up files have to be quaternions (qw, qx, qy, qz)");
+
+        ImGui::DragFloat("Units per File Unit", &settings.unitScale, 0.01f, 0.0001f, 10000.0f, "%.4f");
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Meters"))
+        {
+            // one game unit is an inch
+            settings.unitScale = 39.37f;
+        }
+
+        ImGui::DragFloat("Frame Rate", &settings.frameRate, 0.1f, 1.0f, 1000.0f, "%.2f");
+        ImGui::Checkbox("Angles in Radians", &settings.anglesInRadians);
+
+        if (ImGui::Button("Choose File"))
+        {
+            auto path = PathUtils::OpenFileDialog(false, OFN_EXPLORER | OFN_FILEMUSTEXIST, CAMERA_TRACK_FILE_FILTER,
+                                                  "csv");
+            if (path.has_value())
+            {
+                settings.startTick = Components::Playback::GetTimelineTick();
+                if (Components::CameraTrackImporter::Import(path.value(), settings) > 0)
+                    SetDefaultVerticalZoom();
+                ImGui::CloseCurrentPopup();
+            }
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel"))
+        {
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::EndPopup();
+    }
+
+    void KeyframeEditor::DrawReductionPopup(const Types::KeyframeableProperty& property)
+    {
+        const auto popupLabel = std::format("##reduceProperty{}Popup", property.name);
+
+        if (ImGui::Button(std::format(ICON_FA_COMPRESS "##reduceProperty{}Button", property.name).c_str(),
+                          ImVec2(1, 1) * (ImGui::GetTextLineHeight() + ImGui::GetStyle().FramePadding.y * 2.0f)))
+        {
+            reductionSummary.clear();
+            ImGui::OpenPopup(popupLabel.c_str());
+        }
+
+        if (ImGui::BeginPopup(popupLabel.c_str()))
+        {
+            ImGui::Text("Remove keyframes that stay within the tolerance");
+
+            auto& tolerances = GetReductionTolerances(property);
+            for (int32_t i = 0; i < property.GetValueCount(); i++)
+            {
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+                ImGui::DragFloat(Types::KeyframeValue::GetValueIndexName(property.valueType, i).data(), &tolerances[i],
+                                 tolerances[i] * 0.01f + 0.0001f, 0.0f, FLT_MAX, "%.4f");
+            }
+
+            if (ImGui::Button("Reduce"))
+            {
+                ReduceKeyframes({property});
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Reduce All Tracks"))
+            {
+                std::vector<Types::KeyframeableProperty> properties;
+                for (const auto& [p, keyframes] : Components::KeyframeManager::Get().GetKeyframes())
+                {
+                    if (!keyframes.empty())
+                        properties.push_back(p);
+                }
+                ReduceKeyframes(properties);
+            }
+
+            if (!reductionSummary.empty())
+                ImGui::TextUnformatted(reductionSummary.c_str());
+
+            ImGui::EndPopup();
+        }
+    }
+
+    void KeyframeEditor::DrawSmoothingPopup(const Types::KeyframeableProperty& property)
+    {
+        const auto popupLabel = std::format("Smooth {}##smoothProperty{}Popup", property.name, property.name);
+
+        if (ImGui::Button(std::format(ICON_FA_WAVE_SQUARE "##smoothProperty{}Button", property.name).c_str(),
+                          ImVec2(1, 1) * (ImGui::GetTextLineHeight() + ImGui::GetStyle().FramePadding.y * 2.0f)))
+        {
+            smoothingProperty = property.type;
+            UpdateSmoothingPreview(property);
+            ImGui::OpenPopup(popupLabel.c_str());
+        }
+
+        if (ImGui::BeginPopupModal(popupLabel.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+        {
+            // the track can still change underneath the popup, e.g. through undo, recording or loading a demo
+            if (smoothingSourceRevision != Components::KeyframeManager::Get().GetKeyframesRevision(property))
+                UpdateSmoothingPreview(property);
+
+            auto& settings = smoothingSettings;
+            bool changed = false;
+
+            auto filter = static_cast<int>(settings.filter);
+            changed |= ImGui::Combo("Filter", &filter, "Gaussian\0Savitzky-Golay\0One-Euro\0");
+            settings.filter = static_cast<MathUtils::SmoothingFilter>(filter);
+
+            switch (settings.filter)
+            {
+                case MathUtils::SmoothingFilter::Gaussian:
+                    changed |= ImGui::DragFloat("Sigma (Keyframes)", &settings.sigma, 0.05f, 0.1f, 100.0f, "%.2f");
+                    break;
+                case MathUtils::SmoothingFilter::SavitzkyGolay:
+                    changed |= ImGui::DragInt("Radius (Keyframes)", &settings.radius, 0.1f, 1, 100);
+                    changed |= ImGui::SliderInt("Polynomial Order", &settings.polynomialOrder, 0, 6);
+                    break;
+                case MathUtils::SmoothingFilter::OneEuro:
+                    changed |= ImGui::DragFloat("Min Cutoff (Hz)", &settings.minCutoff, 0.01f, 0.01f, 30.0f, "%.2f");
+                    changed |= ImGui::DragFloat("Beta", &settings.beta, 0.0005f, 0.0f, 10.0f, "%.4f");
+                    changed |= ImGui::DragFloat("Derivative Cutoff (Hz)", &settings.derivativeCutoff, 0.01f, 0.01f,
+                                                30.0f, "%.2f");
+                    break;
+            }
+
+            if (changed)
+                UpdateSmoothingPreview(property);
+
+            if (ImGui::Button("Apply"))
+            {
+                const auto& keyframes = Components::KeyframeManager::Get().GetKeyframes(property);
+                Components::KeyframeManager::Get().SetKeyframeValues(
+                    property, MathUtils::SmoothKeyframes(property, keyframes, smoothingSettings));
+
+                smoothingProperty.reset();
+                smoothingPreview.clear();
+                ImGui::CloseCurrentPopup();
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel"))
+            {
+                smoothingProperty.reset();
+                smoothingPreview.clear();
+                ImGui::CloseCurrentPopup();
+            }
+
+            ImGui::EndPopup();
+        }
+    }
+
+    void KeyframeEditor::UpdateSmoothingPreview(const Types::KeyframeableProperty& property)
+    {
+        auto& keyframeManager = Components::KeyframeManager::Get();
+        smoothingPreview = keyframeManager.GetKeyframes(property);
+        smoothingSourceRevision = keyframeManager.GetKeyframesRevision(property);
+
+        const auto values = MathUtils::SmoothKeyframes(property, smoothingPreview, smoothingSettings);
+        for (std::size_t i = 0; i < smoothingPreview.size(); i++)
+            smoothingPreview[i].value = values[i];
+
+        if (!smoothingPreview.empty())
+            smoothingPreviewTable.Compile(property, smoothingPreview);
+    }
+
+    Types::KeyframeValue KeyframeEditor::EvaluateCurve(const Types::KeyframeableProperty& property,
+                                                       const std::vector<Types::Keyframe>& keyframes,
+                                                       uint32_t tick) const
+    {
+        // the preview is compiled once per change instead of on every evaluation of a foreign track
+        if (&keyframes == &smoothingPreview && !keyframes.empty())
+        {
+            const auto clampedTick = std::clamp(tick, keyframes.front().tick, keyframes.back().tick);
+            return smoothingPreviewTable.Evaluate(static_cast<float>(clampedTick));
+        }
+        return Components::KeyframeManager::Get().Interpolate(property, keyframes, tick);
+    }
+
+    std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT>& KeyframeEditor::GetReductionTolerances(
+        const Types::KeyframeableProperty& property)
+    {
+        auto it = reductionTolerances.find(property);
+        if (it == reductionTolerances.end())
+        {
+            std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT> tolerances{};
+            for (int32_t i = 0; i < property.GetValueCount(); i++)
+                tolerances[i] = MathUtils::GetDefaultReductionTolerance(property, i);
+            it = reductionTolerances.emplace(property, tolerances).first;
+        }
+        return it->second;
+    }
+
+    void KeyframeEditor::ReduceKeyframes(const std::vector<Types::KeyframeableProperty>& properties)
+    {
+        auto& keyframeManager = Components::KeyframeManager::Get();
+
+        // the tracks are reduced in parallel, so everything is looked up beforehand
+        std::vector<const std::vector<Types::Keyframe>*> tracks;
+        std::vector<std::span<const float>> tolerances;
+        for (const auto& property : properties)
+        {
+            tracks.push_back(&keyframeManager.GetKeyframes(property));
+            tolerances.push_back(GetReductionTolerances(property));
+        }
+
+        std::vector<MathUtils::KeyframeReductionResult> results(properties.size());
+        std::vector<std::size_t> indices(properties.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::for_each(std::execution::par, indices.begin(), indices.end(), [&](std::size_t i) {
+            results[i] = MathUtils::ReduceKeyframes(properties[i], *tracks[i], tolerances[i]);
+        });
+
+        std::size_t originalCount = 0;
+        std::size_t removedCount = 0;
+        float maxError = 0.0f;
+        std::string maxErrorValue = "-";
+        float maxErrorRatio = -1.0f;
+
+        std::vector<std::pair<Types::KeyframeableProperty, std::vector<Types::Keyframe>>> removals;
+        for (std::size_t i = 0; i < properties.size(); i++)
+        {
+            originalCount += results[i].originalCount;
+            removedCount += results[i].removedKeyframes.size();
+
+            // the error closest to its tolerance is the most meaningful one across different units
+            for (int32_t j = 0; j < properties[i].GetValueCount(); j++)
+            {
+                const auto ratio = results[i].maxErrors[j] / std::max(tolerances[i][j], 1e-6f);
+                if (ratio > maxErrorRatio)
+                {
+                    maxErrorRatio = ratio;
+                    maxError = results[i].maxErrors[j];
+                    maxErrorValue = std::format("{} {}", properties[i].name,
+                                                Types::KeyframeValue::GetValueIndexName(properties[i].valueType, j));
+                }
+            }
+
+            removals.emplace_back(properties[i], std::move(results[i].removedKeyframes));
+        }
+
+        keyframeManager.RemoveKeyframes(std::move(removals));
+
+        const auto reduction =
+            originalCount > 0 ? 100.0f * static_cast<float>(removedCount) / static_cast<float>(originalCount) : 0.0f;
+        reductionSummary = std::format("{} of {} keyframes removed ({:.1f}%)\nMax error: {:.4f} ({})", removedCount,
+                                       originalCount, reduction, maxError, maxErrorValue);
+        LOG_INFO("Keyframe reduction: {} of {} keyframes removed ({:.1f}%), max error {:.4f} ({})", removedCount,
+                 originalCount, reduction, maxError, maxErrorValue);
     }
 
     void KeyframeEditor::Render()
@@ -863,6 +1192,12 @@ namespace IWXMVM::UI
                     ImGui::TableSetColumnIndex(1);
                     wasInnerAreaHovered = DrawKeyframeSlider(property) || wasInnerAreaHovered;
 
+                    ImGui::SameLine();
+                    DrawSmoothingPopup(property);
+
+                    ImGui::SameLine();
+                    DrawReductionPopup(property);
+
                     ImGui::SameLine();
                     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 0.1f, 0.1f, 1));
                     if (ImGui::Button(std::format(ICON_FA_TRASH "##deleteProperty{}Button", property.name).c_str(), 
@@ -912,6 +1247,8 @@ namespace IWXMVM::UI
                 DrawMiscButtons(padding, hasKeyframes);
             }
 
+            DrawCameraTrackImportPopup();
+
             if (ImGui::BeginPopupModal(CLEAR_KEYFRAMES_POPUP_LABEL, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
             {
                 ImGui::Text("This will delete all currently placed keyframes");
@@ -2,6 +2,9 @@
 #include "UI/UIComponent.hpp"
 #include "Types/KeyframeableProperty.hpp"
 #include "Types/Keyframe.hpp"
+#include "Utilities/KeyframeFilters.hpp"
+#include "Utilities/SegmentTable.hpp"
+#include "Components/CameraTrackImporter.hpp"
 
 namespace IWXMVM::UI
 {
@@ -36,9 +39,33 @@ namespace IWXMVM::UI
         bool DrawKeyframeSlider(const Types::KeyframeableProperty& property);
 
         void DrawMiscButtons(ImVec2 padding, bool hasKeyframes);
+        void DrawCameraTrackImportPopup();
+
+        void DrawReductionPopup(const Types::KeyframeableProperty& property);
+        std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT>& GetReductionTolerances(
+            const Types::KeyframeableProperty& property);
+        void ReduceKeyframes(const std::vector<Types::KeyframeableProperty>& properties);
+
+        // the filtered values are previewed on a copy of the track, which is only touched once they are applied
+        void DrawSmoothingPopup(const Types::KeyframeableProperty& property);
+        void UpdateSmoothingPreview(const Types::KeyframeableProperty& property);
+        Types::KeyframeValue EvaluateCurve(const Types::KeyframeableProperty& property,
+                                           const std::vector<Types::Keyframe>& keyframes, uint32_t tick) const;
 
         int32_t displayStartTick, displayEndTick;
 
         std::map<Types::KeyframeableProperty, bool> propertyVisible;
+
+        std::map<Types::KeyframeableProperty, std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT>>
+            reductionTolerances;
+        std::string reductionSummary;
+
+        Components::CameraTrackImporter::Settings cameraTrackImportSettings;
+
+        MathUtils::SmoothingSettings smoothingSettings;
+        std::optional<Types::KeyframeablePropertyType> smoothingProperty;
+        std::optional<uint32_t> smoothingSourceRevision;
+        std::vector<Types::Keyframe> smoothingPreview;
+        MathUtils::SegmentTable smoothingPreviewTable;
     };
 }  // namespace IWXMVM::UI
\ No newline at end of file
@@ -26,6 +26,7 @@ namespace IWXMVM::UI
 
         DrawHeading("General");
         ImGui::Checkbox("Show Keybind Hints in Game View", &preferences.showKeybindHints);
+        ImGui::DragInt("Undo History Memory (MB)", &preferences.undoHistoryMemoryBudget, 1.0f, 1, 1024);
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 10);
     }
 
@@ -8,7 +8,9 @@
 #include "Resources.hpp"
 #include "Input.hpp"
 #include "Components/CameraManager.hpp"
+#include "Components/Playback.hpp"
 #include "Utilities/MathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 #include "UI/TaskbarProgress.hpp"
 
 namespace IWXMVM::UI
@@ -37,8 +39,17 @@ namespace IWXMVM::UI
 
     void UIManager::RunImGuiFrame()
     {
+        PROFILE_FUNCTION();
+
         try
         {
+            // while seeking, the previous frame's interface is drawn again instead of building a new one
+            if (Components::Playback::IsFastSeeking() && ImGui::GetDrawData() != nullptr)
+            {
+                ImGui_ImplDX9_RenderDrawData(ImGui::GetDrawData());
+                return;
+            }
+
             ImGui_ImplDX9_NewFrame();
             ImGui_ImplWin32_NewFrame();
             ImGui::NewFrame();
@@ -90,7 +101,7 @@ namespace IWXMVM::UI
                 GetUIComponent(Component::DebugPanel)->Render();
             }
 
-            Events::Invoke(EventType::OnFrame);
+            Events::Invoke<EventType::OnFrame>();
 
             ImGui::EndFrame();
             ImGui::Render();
@@ -0,0 +1,147 @@
+#include "StdInclude.hpp"
+#include "ArcLengthTable.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    namespace
+    {
+        // 5-point Gauss-Legendre abscissae and weights on [-1, 1]
+        constexpr std::array<double, 5> GAUSS_NODES = {0.0, -0.5384693101056831, 0.5384693101056831,
+                                                       -0.9061798459386640, 0.9061798459386640};
+        constexpr std::array<double, 5> GAUSS_WEIGHTS = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665,
+                                                         0.2369268850561891, 0.2369268850561891};
+
+        constexpr double TOLERANCE = 1e-3;  // in game units
+        constexpr int32_t MAX_DEPTH = 8;
+
+        double GetSpeed(const ArcLengthTable::VelocityFunction& velocity, double tick)
+        {
+            return glm::length(velocity(static_cast<float>(tick)));
+        }
+
+        double IntegrateGaussLegendre(const ArcLengthTable::VelocityFunction& velocity, double a, double b)
+        {
+            const auto halfLength = 0.5 * (b - a);
+            const auto center = 0.5 * (a + b);
+
+            double sum = 0.0;
+            for (std::size_t i = 0; i < GAUSS_NODES.size(); i++)
+                sum += GAUSS_WEIGHTS[i] * GetSpeed(velocity, center + halfLength * GAUSS_NODES[i]);
+            return sum * halfLength;
+        }
+
+        double IntegrateAdaptive(const ArcLengthTable::VelocityFunction& velocity, double a, double b, double whole,
+                                 double tolerance, int32_t depth)
+        {
+            const auto mid = 0.5 * (a + b);
+            const auto left = IntegrateGaussLegendre(velocity, a, mid);
+            const auto right = IntegrateGaussLegendre(velocity, mid, b);
+
+            if (depth <= 0 || std::abs(left + right - whole) <= tolerance)
+                return left + right;
+
+            return IntegrateAdaptive(velocity, a, mid, left, tolerance * 0.5, depth - 1) +
+                   IntegrateAdaptive(velocity, mid, b, right, tolerance * 0.5, depth - 1);
+        }
+    }  // namespace
+
+    ArcLengthTable::Segment ArcLengthTable::BuildSegment(float startTick, float endTick,
+                                                         const VelocityFunction& velocity)
+    {
+        Segment segment{startTick, endTick, {}};
+
+        const auto step = (static_cast<double>(endTick) - startTick) / SAMPLES_PER_SEGMENT;
+        double distance = 0.0;
+        for (std::size_t i = 0; i < SAMPLES_PER_SEGMENT; i++)
+        {
+            const auto a = startTick + step * i;
+            const auto b = a + step;
+            distance += IntegrateAdaptive(velocity, a, b, IntegrateGaussLegendre(velocity, a, b),
+                                          TOLERANCE / SAMPLES_PER_SEGMENT, MAX_DEPTH);
+            segment.distances[i + 1] = static_cast<float>(distance);
+        }
+        return segment;
+    }
+
+    void ArcLengthTable::Update(const std::vector<Types::Keyframe>& keyframes, const VelocityFunction& velocity,
+                                bool interpolationChanged)
+    {
+        std::vector<Node> newNodes;
+        newNodes.reserve(keyframes.size());
+        for (const auto& keyframe : keyframes)
+            newNodes.push_back({keyframe.tick, keyframe.value.cameraData.position, keyframe.interpolation});
+
+        if (!interpolationChanged && newNodes == nodes)
+            return;
+
+        // nodes that are unchanged at the front and the back of the path
+        std::size_t prefix = 0;
+        std::size_t suffix = 0;
+        if (!interpolationChanged)
+        {
+            const auto shared = std::min(nodes.size(), newNodes.size());
+            while (prefix < shared && nodes[prefix] == newNodes[prefix])
+                prefix++;
+            while (suffix < shared - prefix &&
+                   nodes[nodes.size() - 1 - suffix] == newNodes[newNodes.size() - 1 - suffix])
+                suffix++;
+        }
+
+        // a cubic spline node influences the whole path, but its effect shrinks by a factor of about 2 - sqrt(3) with
+        // every node in between, so segments more than 8 nodes away change by less than 0.01%
+        constexpr std::size_t REACH = 8;
+        const auto keptFront = prefix > REACH ? prefix - REACH : 0;
+        const auto keptBack = suffix > REACH ? suffix - REACH : 0;
+
+        const auto newSegmentCount = newNodes.size() > 1 ? newNodes.size() - 1 : 0;
+
+        std::vector<Segment> newSegments;
+        newSegments.reserve(newSegmentCount);
+        for (std::size_t i = 0; i < newSegmentCount; i++)
+        {
+            const auto fromBack = newSegmentCount - 1 - i;
+            if (i < keptFront && i < segments.size())
+                newSegments.push_back(segments[i]);
+            else if (fromBack < keptBack && fromBack < segments.size())
+                newSegments.push_back(segments[segments.size() - 1 - fromBack]);
+            else
+                newSegments.push_back(BuildSegment(static_cast<float>(newNodes[i].tick),
+                                                   static_cast<float>(newNodes[i + 1].tick), velocity));
+        }
+
+        nodes = std::move(newNodes);
+        segments = std::move(newSegments);
+
+        segmentStartDistances.resize(segments.size() + 1);
+        segmentStartDistances[0] = 0.0f;
+        for (std::size_t i = 0; i < segments.size(); i++)
+            segmentStartDistances[i + 1] = segmentStartDistances[i] + segments[i].distances.back();
+    }
+
+    float ArcLengthTable::GetTotalLength() const
+    {
+        return segmentStartDistances.empty() ? 0.0f : segmentStartDistances.back();
+    }
+
+    float ArcLengthTable::GetTickAtDistance(float distance) const
+    {
+        assert(!segments.empty());
+
+        distance = std::clamp(distance, 0.0f, GetTotalLength());
+
+        const auto nextSegment =
+            std::upper_bound(segmentStartDistances.begin() + 1, segmentStartDistances.end() - 1, distance);
+        const auto& segment = segments[std::distance(segmentStartDistances.begin() + 1, nextSegment)];
+        const auto localDistance = distance - *(nextSegment - 1);
+
+        const auto nextSample =
+            std::upper_bound(segment.distances.begin() + 1, segment.distances.end() - 1, localDistance);
+        const auto sample = std::distance(segment.distances.begin(), nextSample) - 1;
+
+        const auto sampleLength = segment.distances[sample + 1] - segment.distances[sample];
+        const auto t = sampleLength > 0.0f ? (localDistance - segment.distances[sample]) / sampleLength : 0.0f;
+
+        const auto step = (segment.endTick - segment.startTick) / static_cast<float>(SAMPLES_PER_SEGMENT);
+        return segment.startTick + step * (static_cast<float>(sample) + t);
+    }
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,50 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Maps distance travelled along a camera path back to the tick at which it is reached, which allows playing the
+    // path back at constant speed regardless of how the nodes are spaced in time. Every segment between two nodes
+    // stores the cumulative arc length at a fixed number of sub-ticks, each integrated with adaptive Gauss-Legendre
+    // quadrature of the path's speed. When the path changes, only the segments around the modified nodes are
+    // integrated again.
+    class ArcLengthTable
+    {
+       public:
+        // Derivative of the position along the path, in units per tick (see SegmentTable::EvaluateVector3Derivative)
+        using VelocityFunction = std::function<glm::vec3(float tick)>;
+
+        // Brings the table in sync with the given nodes; interpolationChanged forces a full rebuild, since switching
+        // between linear and cubic interpolation changes the shape of every segment
+        void Update(const std::vector<Types::Keyframe>& keyframes, const VelocityFunction& velocity,
+                    bool interpolationChanged);
+
+        float GetTotalLength() const;
+        float GetTickAtDistance(float distance) const;
+
+       private:
+        static constexpr std::size_t SAMPLES_PER_SEGMENT = 16;
+
+        struct Node
+        {
+            uint32_t tick;
+            glm::vec3 position;
+            Types::KeyframeInterpolation interpolation;
+
+            bool operator==(const Node& other) const = default;
+        };
+
+        struct Segment
+        {
+            float startTick;
+            float endTick;
+            std::array<float, SAMPLES_PER_SEGMENT + 1> distances;  // cumulative, relative to the segment start
+        };
+
+        static Segment BuildSegment(float startTick, float endTick, const VelocityFunction& velocity);
+
+        std::vector<Node> nodes;
+        std::vector<Segment> segments;
+        std::vector<float> segmentStartDistances;
+    };
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,117 @@
+#include "StdInclude.hpp"
+#include "DemoIndex.hpp"
+
+namespace IWXMVM::DemoIndex
+{
+    enum class DemoMessageType : uint8_t
+    {
+        NetworkPacket = 0,
+        ClientArchive = 1,
+        CoD4XProtocolHeader = 2
+    };
+
+    void SkipBytes(std::istream& file, const int size)
+    {
+        file.seekg(size, std::ios::cur);
+    }
+
+    void ReadDemoArchives(std::istream& file, std::vector<ClientArchive>& archives)
+    {
+        ClientArchive archive;
+        file.read(reinterpret_cast<char*>(&archive), sizeof(ClientArchive));
+
+        if (archives.empty() || archive.serverTime > archives.back().serverTime)
+        {
+            archives.emplace_back(archive);
+        }
+    }
+
+    Index Build(std::istream& file)
+    {
+        Index index;
+
+        while (true)
+        {
+            char messageType;
+            file.read(&messageType, 1);
+
+            if (file.eof())
+                break;
+
+            switch (messageType)
+            {
+                case (uint8_t)DemoMessageType::NetworkPacket:
+                {
+                    int messageSize = -2;
+
+                    SkipBytes(file, 4);
+                    file.read(reinterpret_cast<char*>(&messageSize), 4);
+                    SkipBytes(file, 4);
+
+                    if (file.eof() || messageSize == -1)
+                    {
+                        break;
+                    }
+
+                    SkipBytes(file, messageSize - 4);
+                    continue;
+                }
+                case (uint8_t)DemoMessageType::ClientArchive:
+                    ReadDemoArchives(file, index.archives);
+                    continue;
+                case (uint8_t)DemoMessageType::CoD4XProtocolHeader:
+                    SkipBytes(file, 16);
+                    continue;
+                default:
+                    index.unhandledMessageCount++;
+                    break;
+            }
+        }
+
+        return index;
+    }
+
+    std::optional<std::pair<uint32_t, uint32_t>> GetTickRange(const Index& index, std::string& error)
+    {
+        const auto& archives = index.archives;
+        if (archives.size() < 2)
+        {
+            error = "Could not determine demo length due to lack of client archives (found " +
+                    std::to_string(archives.size()) + ")";
+            return std::nullopt;
+        }
+
+        uint32_t demoStartTick = 0;
+        uint32_t demoEndTick = 0;
+
+        // some of the first batch of 256 archives are outdated (cod4)
+        for (auto itr = archives.begin(); itr != archives.end(); ++itr)
+        {
+            // don't use server times that are <= 0
+            if (itr->serverTime > 0)
+            {
+                demoStartTick = static_cast<std::uint32_t>(itr->serverTime);
+                break;
+            }
+        }
+
+        for (auto itr = archives.rbegin(); itr != archives.rend(); ++itr)
+        {
+            // don't use server times that are <= demo start tick
+            if (itr->serverTime > static_cast<std::int32_t>(demoStartTick))
+            {
+                demoEndTick = 500 + static_cast<std::uint32_t>(itr->serverTime);
+                break;
+            }
+        }
+
+        if (demoStartTick == 0 || demoEndTick == 0 || demoEndTick - demoStartTick > 3600 * 1000 ||
+            static_cast<std::int32_t>(demoEndTick - demoStartTick) < 1000)
+        {
+            error = "Could not determine demo length due to invalid archives. Cannot render timeline.";
+            return std::nullopt;
+        }
+
+        return std::make_pair(demoStartTick, demoEndTick);
+    }
+}  // namespace IWXMVM::DemoIndex
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace IWXMVM::DemoIndex
+{
+    // The player state a demo stores every few frames, its server times tell how long the demo is
+    struct ClientArchive
+    {
+        int archiveIndex;
+        float origin[3];
+        float velocity[3];
+        int movementDir;
+        int bobCycle;
+        int serverTime;
+        float viewAngles[3];
+    };
+
+    struct Index
+    {
+        std::vector<ClientArchive> archives;  // only those with increasing server times
+        std::size_t unhandledMessageCount = 0;
+    };
+
+    // Walks over the messages of a demo and collects its client archives
+    Index Build(std::istream& file);
+
+    // First and last tick of a demo. Returns nullopt and sets error if the archives don't give a sensible range.
+    std::optional<std::pair<uint32_t, uint32_t>> GetTickRange(const Index& index, std::string& error);
+}  // namespace IWXMVM::DemoIndex
@@ -0,0 +1,272 @@
+#include "StdInclude.hpp"
+#include "DemoReads.hpp"
+
+namespace IWXMVM::DemoReads
+{
+    namespace
+    {
+        // Trace format: a header followed by one record per read. Reads are almost always sequential and a few ms of
+        // server time apart, so each record stores the offset relative to the end of the previous read, the actual
+        // file position relative to the offset, the length and the server time relative to the previous read, as
+        // zigzag encoded varints. Most records are 4 bytes long.
+        constexpr std::array<char, 4> TRACE_MAGIC = {'I', 'W', 'X', 'D'};
+        constexpr uint32_t TRACE_VERSION = 2;
+
+        struct TraceHeader
+        {
+            std::array<char, 4> magic;
+            uint32_t version;
+            uint32_t readCount;
+            uint32_t demoPathLength;
+            // followed by the demo path and the records
+        };
+
+        constexpr std::size_t MAX_REPORTED_VIOLATIONS = 10;
+
+        void WriteVarint(std::vector<char>& buffer, uint32_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        std::optional<uint32_t> ReadVarint(std::span<const char> data, std::size_t& position)
+        {
+            uint32_t value = 0;
+            for (uint32_t shift = 0; shift < 35 && position < data.size(); shift += 7)
+            {
+                const auto byte = static_cast<uint8_t>(data[position++]);
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return value;
+            }
+            return std::nullopt;
+        }
+
+        uint32_t EncodeZigzag(int32_t value)
+        {
+            return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+        }
+
+        int32_t DecodeZigzag(uint32_t value)
+        {
+            return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+        }
+    }  // namespace
+
+    DemoReadType BeginRead(DemoFileState& state, int len)
+    {
+        // only reset when the game has just requested the one byte message type
+        if (len == 1)
+            return state.offset + 9 >= state.size ? DemoReadType::Footer : DemoReadType::MessageType;
+
+        // to exclude client archives (and CoD4X protocol header)
+        if (len <= 12)
+            return DemoReadType::Other;
+
+        // TODO: find a more robust method of detecting a gamestate message
+        if (len >= 10'000 || state.offset == 9)
+        {
+            // first message with the gamestate; triggers the game to load a map
+            // clear old data in case this not the first gamestate in the demo
+            state.restartOffset.reset();
+            state.hasFirstSnapshot = false;
+            return DemoReadType::Gamestate;
+        }
+
+        if (!state.restartOffset.has_value())
+        {
+            // after gamestate before first snapshot
+            state.restartOffset = state.offset - 9;
+            assert(state.restartOffset.value() > 0);
+            return DemoReadType::FirstMessage;
+        }
+
+        if (!state.hasFirstSnapshot)
+        {
+            // after first snapshot and before second snapshot
+            state.hasFirstSnapshot = true;
+            return DemoReadType::FirstSnapshot;
+        }
+
+        return DemoReadType::Other;
+    }
+
+    void FinishRead(DemoFileState& state, int len)
+    {
+        state.offset += len;
+    }
+
+    bool RestartFile(DemoFileState& state)
+    {
+        if (!state.restartOffset.has_value())
+            return false;
+
+        state.offset = state.restartOffset.value();
+        return true;
+    }
+
+    TraceRecorder::TraceRecorder(std::string demoPath) : demoPath(std::move(demoPath))
+    {
+    }
+
+    void TraceRecorder::Record(uint32_t offset, uint32_t filePosition, uint32_t length, int32_t serverTime)
+    {
+        WriteVarint(records, EncodeZigzag(static_cast<int32_t>(offset - expectedOffset)));
+        WriteVarint(records, EncodeZigzag(static_cast<int32_t>(filePosition - offset)));
+        WriteVarint(records, length);
+        WriteVarint(records, EncodeZigzag(serverTime - previousServerTime));
+
+        readCount++;
+        expectedOffset = offset + length;
+        previousServerTime = serverTime;
+    }
+
+    bool TraceRecorder::WriteFile(const std::filesystem::path& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        const TraceHeader header{TRACE_MAGIC, TRACE_VERSION, readCount, static_cast<uint32_t>(demoPath.size())};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(demoPath.data(), demoPath.size());
+        file.write(records.data(), records.size());
+        return !file.fail();
+    }
+
+    std::optional<ReplayResult> Replay(const std::filesystem::path& tracePath, const std::filesystem::path& demoPath,
+                                       std::string& error)
+    {
+        std::ifstream traceFile(tracePath, std::ios::binary);
+        if (!traceFile.is_open())
+        {
+            error = "Failed to open demo read trace " + tracePath.string();
+            return std::nullopt;
+        }
+
+        const std::vector<char> data(std::istreambuf_iterator<char>(traceFile), {});
+        TraceHeader header;
+        if (data.size() < sizeof(header))
+        {
+            error = "Demo read trace " + tracePath.string() + " is truncated";
+            return std::nullopt;
+        }
+
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != TRACE_MAGIC || header.version != TRACE_VERSION ||
+            header.demoPathLength > data.size() - sizeof(header))
+        {
+            error = tracePath.string() + " is not a valid demo read trace";
+            return std::nullopt;
+        }
+
+        const auto replayedDemoPath =
+            demoPath.empty() ? std::filesystem::path(std::string(data.data() + sizeof(header), header.demoPathLength))
+                             : demoPath;
+        std::ifstream demoFile(replayedDemoPath, std::ios::binary);
+        if (!demoFile.is_open())
+        {
+            error = "Failed to open demo " + replayedDemoPath.string() + " for replaying demo reads";
+            return std::nullopt;
+        }
+
+        DemoFileState state;
+        demoFile.seekg(0, std::ios::end);
+        state.size = static_cast<uint32_t>(demoFile.tellg());
+        demoFile.seekg(0, std::ios::beg);
+
+        ReplayResult result{};
+        auto ReportViolation = [&](std::size_t readIndex, std::string_view description) {
+            if (result.violationCount++ < MAX_REPORTED_VIOLATIONS)
+                result.violations.push_back("Demo read " + std::to_string(readIndex) + " " + std::string(description));
+        };
+
+        const auto recordData = std::span(data).subspan(sizeof(header) + header.demoPathLength);
+        std::size_t position = 0;
+        uint32_t recordedOffset = 0;
+        int32_t serverTime = 0;
+        std::vector<char> buffer;
+        bool hasReadGamestate = false;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < header.readCount; i++)
+        {
+            const auto offsetDelta = ReadVarint(recordData, position);
+            const auto filePositionDelta = ReadVarint(recordData, position);
+            const auto length = ReadVarint(recordData, position);
+            const auto serverTimeDelta = ReadVarint(recordData, position);
+            if (!offsetDelta.has_value() || !filePositionDelta.has_value() || !length.has_value() ||
+                !serverTimeDelta.has_value())
+            {
+                error = "Demo read trace " + tracePath.string() + " ends after " + std::to_string(i) + " of " +
+                        std::to_string(header.readCount) + " reads";
+                return std::nullopt;
+            }
+
+            recordedOffset += static_cast<uint32_t>(DecodeZigzag(offsetDelta.value()));
+            serverTime += DecodeZigzag(serverTimeDelta.value());
+
+            if (DecodeZigzag(filePositionDelta.value()) != 0)
+                ReportViolation(i, "was made while the demo file was out of sync with the tracked offset");
+
+            // the recording may have started in the middle of the demo
+            if (i == 0)
+            {
+                state.offset = recordedOffset;
+                demoFile.seekg(state.offset);
+            }
+
+            const auto previousOffset = state.offset;
+            const auto readType = BeginRead(state, static_cast<int>(length.value()));
+            hasReadGamestate = hasReadGamestate || readType == DemoReadType::Gamestate;
+            if (recordedOffset != state.offset)
+            {
+                if (!hasReadGamestate || !state.restartOffset.has_value())
+                {
+                    // the gamestate was read before the recording started, so there is nothing to compare against
+                    state.offset = recordedOffset;
+                }
+                else if (readType != DemoReadType::MessageType && readType != DemoReadType::Footer)
+                {
+                    ReportViolation(i, "seeked somewhere other than before a message");
+                    state.offset = recordedOffset;
+                }
+                else if (!RestartFile(state) || state.offset != recordedOffset)
+                {
+                    ReportViolation(i, "seeked somewhere other than the first message after the gamestate");
+                    state.offset = recordedOffset;
+                }
+
+                demoFile.clear();
+                demoFile.seekg(state.offset);
+                result.seekCount++;
+            }
+
+            // the server time only goes back when the game is rewound, which always seeks back in the file
+            if (DecodeZigzag(serverTimeDelta.value()) < 0 && state.offset >= previousOffset)
+                ReportViolation(i, "went back in time without seeking back in the file");
+
+            if (state.offset + static_cast<uint64_t>(length.value()) > state.size)
+                ReportViolation(i, "reads past the end of the demo");
+
+            buffer.resize(std::max<std::size_t>(buffer.size(), length.value()));
+            demoFile.read(buffer.data(), length.value());
+            FinishRead(state, static_cast<int>(length.value()));
+            recordedOffset += length.value();  // offsets are recorded relative to the end of the previous read
+            result.byteCount += static_cast<uint64_t>(demoFile.gcount());
+            result.readCount++;
+
+            // the same check as the assert in Rewinding::FS_Read
+            if (demoFile.good() && static_cast<uint64_t>(demoFile.tellg()) != state.offset)
+                ReportViolation(i, "left the demo file somewhere other than the tracked offset");
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+    }
+}  // namespace IWXMVM::DemoReads
@@ -0,0 +1,74 @@
+#pragma once
+
+namespace IWXMVM::DemoReads
+{
+    // Position in the demo file and where playback restarts from when rewinding. Rewinding drives this with the reads
+    // the game makes and the trace replayer with recorded ones, so it must not touch the game.
+    struct DemoFileState
+    {
+        uint32_t size = 0;
+        uint32_t offset = 0;
+        std::optional<uint32_t> restartOffset;  // first message after the initial gamestate
+        bool hasFirstSnapshot = false;
+    };
+
+    enum class DemoReadType
+    {
+        MessageType,     // the one byte message type, before which a rewind restarts the file
+        Footer,          // a message type that would run into the demo footer
+        Gamestate,       // forgets the previous restart offset
+        FirstMessage,    // sets the restart offset
+        FirstSnapshot,
+        Other,
+    };
+
+    // Updates the gamestate bookkeeping for a read of len bytes at the current offset, FinishRead advances it
+    DemoReadType BeginRead(DemoFileState& state, int len);
+    void FinishRead(DemoFileState& state, int len);
+    // Moves the offset back to the restart offset, unless the initial gamestate hasn't been read yet
+    bool RestartFile(DemoFileState& state);
+
+    // Builds a trace of every read the game makes from a demo file, so a sequence of reads that led to a rewinding
+    // bug or slowdown can be replayed against the same demo later
+    class TraceRecorder
+    {
+       public:
+        explicit TraceRecorder(std::string demoPath);
+
+        // offset is where the bookkeeping believes the read starts, filePosition where the demo file actually is
+        void Record(uint32_t offset, uint32_t filePosition, uint32_t length, int32_t serverTime);
+        bool WriteFile(const std::filesystem::path& path) const;
+
+        uint32_t GetReadCount() const
+        {
+            return readCount;
+        }
+
+        std::size_t GetRecordSize() const
+        {
+            return records.size();
+        }
+
+       private:
+        std::string demoPath;
+        std::vector<char> records;
+        uint32_t readCount = 0;
+        uint32_t expectedOffset = 0;
+        int32_t previousServerTime = 0;
+    };
+
+    struct ReplayResult
+    {
+        std::size_t readCount;
+        std::size_t seekCount;
+        uint64_t byteCount;
+        double milliseconds;
+        std::size_t violationCount;  // reads that broke one of the invariants the rewinding code relies on
+        std::vector<std::string> violations;  // descriptions of the first few
+    };
+
+    // Performs the recorded reads on a demo, driving the same offset and gamestate bookkeeping as Rewinding. The demo
+    // is the one the trace was recorded with, unless demoPath is given. On failure error describes what went wrong.
+    std::optional<ReplayResult> Replay(const std::filesystem::path& tracePath, const std::filesystem::path& demoPath,
+                                       std::string& error);
+}  // namespace IWXMVM::DemoReads
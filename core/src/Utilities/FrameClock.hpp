@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+namespace IWXMVM::MathUtils
+{
+    // Splits demo time into frames of 1000 * denominator / numerator ms in whole ticks, so that fractional rates like
+    // 24000 / 1001 (23.976 fps) are exact. That usually isn't a whole number of ticks; the remainder is accumulated
+    // and added back as an extra tick whenever it exceeds one, so it never drifts.
+    // Only depends on the standard library, so the frame logic can be built and checked without the game.
+    class FrameClock
+    {
+       public:
+        explicit FrameClock(int32_t numerator = 30, int32_t denominator = 1)
+            : numerator(numerator), denominator(denominator)
+        {
+        }
+
+        void Reset(int32_t newNumerator, int32_t newDenominator = 1)
+        {
+            numerator = newNumerator;
+            denominator = newDenominator;
+            remainder = 0;
+        }
+
+        // Returns the number of ticks the next frame is long
+        int32_t Advance()
+        {
+            const auto frameLength = 1000 * denominator;  // in 1 / numerator ms
+            auto delta = frameLength / numerator;
+            remainder += frameLength % numerator;
+            if (remainder >= numerator)
+            {
+                remainder -= numerator;
+                delta++;
+            }
+            return delta;
+        }
+
+        // How far past its last whole tick the current frame is, in ticks
+        double GetTickFraction() const
+        {
+            return static_cast<double>(remainder) / numerator;
+        }
+
+       private:
+        int32_t numerator;
+        int32_t denominator;
+        int32_t remainder = 0;  // in 1 / numerator ms
+    };
+}  // namespace IWXMVM::MathUtils
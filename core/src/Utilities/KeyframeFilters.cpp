@@ -0,0 +1,200 @@
+#include "StdInclude.hpp"
+#include "KeyframeFilters.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    namespace
+    {
+        bool IsAngle(Types::KeyframeValueType valueType, std::size_t valueIndex)
+        {
+            return valueType == Types::KeyframeValueType::CameraData && valueIndex >= 3 && valueIndex <= 5;
+        }
+
+        std::vector<float> GetGaussianKernel(float sigma)
+        {
+            const auto radius = static_cast<int32_t>(std::ceil(3.0f * sigma));
+
+            std::vector<float> kernel(2 * radius + 1);
+            for (int32_t i = -radius; i <= radius; i++)
+                kernel[i + radius] = std::exp(-0.5f * static_cast<float>(i * i) / (sigma * sigma));
+
+            const auto sum = std::accumulate(kernel.begin(), kernel.end(), 0.0f);
+            for (auto& weight : kernel)
+                weight /= sum;
+            return kernel;
+        }
+
+        // Weights that evaluate the least squares polynomial through the window at its center
+        std::vector<float> GetSavitzkyGolayKernel(int32_t radius, int32_t polynomialOrder)
+        {
+            const auto size = static_cast<std::size_t>(polynomialOrder + 1);
+
+            // normal equations (J^T * J) * a = e0, where J holds the powers of every position in the window
+            std::vector<double> matrix(size * (size + 1));
+            for (std::size_t row = 0; row < size; row++)
+            {
+                for (std::size_t column = 0; column < size; column++)
+                {
+                    double sum = 0.0;
+                    for (int32_t x = -radius; x <= radius; x++)
+                        sum += std::pow(static_cast<double>(x), static_cast<double>(row + column));
+                    matrix[row * (size + 1) + column] = sum;
+                }
+                matrix[row * (size + 1) + size] = row == 0 ? 1.0 : 0.0;
+            }
+
+            // Gauss-Jordan elimination with partial pivoting
+            for (std::size_t pivot = 0; pivot < size; pivot++)
+            {
+                auto best = pivot;
+                for (std::size_t row = pivot + 1; row < size; row++)
+                {
+                    if (std::abs(matrix[row * (size + 1) + pivot]) > std::abs(matrix[best * (size + 1) + pivot]))
+                        best = row;
+                }
+                for (std::size_t column = 0; column <= size; column++)
+                    std::swap(matrix[pivot * (size + 1) + column], matrix[best * (size + 1) + column]);
+
+                const auto divisor = matrix[pivot * (size + 1) + pivot];
+                for (std::size_t column = 0; column <= size; column++)
+                    matrix[pivot * (size + 1) + column] /= divisor;
+
+                for (std::size_t row = 0; row < size; row++)
+                {
+                    const auto factor = matrix[row * (size + 1) + pivot];
+                    if (row == pivot || factor == 0.0)
+                        continue;
+                    for (std::size_t column = 0; column <= size; column++)
+                        matrix[row * (size + 1) + column] -= factor * matrix[pivot * (size + 1) + column];
+                }
+            }
+
+            std::vector<float> kernel(2 * radius + 1);
+            for (int32_t x = -radius; x <= radius; x++)
+            {
+                double weight = 0.0;
+                for (std::size_t k = 0; k < size; k++)
+                    weight += matrix[k * (size + 1) + size] * std::pow(static_cast<double>(x), static_cast<double>(k));
+                kernel[x + radius] = static_cast<float>(weight);
+            }
+            return kernel;
+        }
+
+        void Convolve(std::span<const float> values, std::span<const float> kernel, std::span<float> output)
+        {
+            const auto n = values.size();
+            const auto radius = kernel.size() / 2;
+
+            // the values at both ends are repeated past them
+            std::vector<float> padded(n + 2 * radius);
+            std::fill_n(padded.begin(), radius, values.front());
+            std::copy(values.begin(), values.end(), padded.begin() + radius);
+            std::fill_n(padded.begin() + radius + n, radius, values.back());
+
+            // taps in the outer loop, so the inner loop is a plain multiply-add over contiguous memory that gets
+            // vectorized by the compiler
+            std::fill(output.begin(), output.end(), 0.0f);
+            for (std::size_t k = 0; k < kernel.size(); k++)
+            {
+                const auto weight = kernel[k];
+                const auto* source = padded.data() + k;
+                auto* destination = output.data();
+                for (std::size_t i = 0; i < n; i++)
+                    destination[i] += weight * source[i];
+            }
+        }
+
+        void FilterOneEuro(std::span<const float> ticks, std::span<const float> values,
+                           const SmoothingSettings& settings, std::span<float> output)
+        {
+            auto GetAlpha = [](float cutoff, float deltaTime) {
+                const auto tau = 1.0f / (glm::two_pi<float>() * std::max(cutoff, 1e-6f));
+                return 1.0f / (1.0f + tau / deltaTime);
+            };
+
+            output[0] = values[0];
+            float derivative = 0.0f;
+            for (std::size_t i = 1; i < values.size(); i++)
+            {
+                // ticks are milliseconds
+                const auto deltaTime = std::max((ticks[i] - ticks[i - 1]) / 1000.0f, 1e-6f);
+
+                const auto rawDerivative = (values[i] - output[i - 1]) / deltaTime;
+                derivative += GetAlpha(settings.derivativeCutoff, deltaTime) * (rawDerivative - derivative);
+
+                const auto cutoff = settings.minCutoff + settings.beta * std::abs(derivative);
+                output[i] = output[i - 1] + GetAlpha(cutoff, deltaTime) * (values[i] - output[i - 1]);
+            }
+        }
+    }  // namespace
+
+    std::vector<Types::KeyframeValue> SmoothKeyframes(const Types::KeyframeableProperty& property,
+                                                      const std::vector<Types::Keyframe>& keyframes,
+                                                      const SmoothingSettings& settings)
+    {
+        const auto n = keyframes.size();
+        const auto valueCount = static_cast<std::size_t>(property.GetValueCount());
+
+        std::vector<Types::KeyframeValue> result(n);
+        for (std::size_t i = 0; i < n; i++)
+            result[i] = keyframes[i].value;
+
+        if (n < 3)
+            return result;
+
+        std::vector<float> ticks(n);
+        for (std::size_t i = 0; i < n; i++)
+            ticks[i] = static_cast<float>(keyframes[i].tick);
+
+        // one contiguous channel per value, with angles unwrapped so that every key is within 180 degrees of the
+        // previous one
+        std::vector<float> values(valueCount * n);
+        for (std::size_t j = 0; j < valueCount; j++)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                auto value = keyframes[i].value.GetByIndex(static_cast<uint32_t>(j));
+                if (i > 0 && IsAngle(property.valueType, j))
+                    value += 360.0f * std::round((values[j * n + i - 1] - value) / 360.0f);
+                values[j * n + i] = value;
+            }
+        }
+
+        std::vector<float> kernel;
+        if (settings.filter == SmoothingFilter::Gaussian)
+        {
+            kernel = GetGaussianKernel(std::max(settings.sigma, 0.1f));
+        }
+        else if (settings.filter == SmoothingFilter::SavitzkyGolay)
+        {
+            const auto radius = std::max(settings.radius, 1);
+            kernel = GetSavitzkyGolayKernel(radius, std::clamp(settings.polynomialOrder, 0, 2 * radius));
+        }
+
+        std::vector<float> smoothed(valueCount * n);
+        std::vector<std::size_t> valueIndices(valueCount);
+        std::iota(valueIndices.begin(), valueIndices.end(), 0);
+        std::for_each(std::execution::par, valueIndices.begin(), valueIndices.end(), [&](std::size_t j) {
+            const auto channel = std::span<const float>(values).subspan(j * n, n);
+            const auto output = std::span<float>(smoothed).subspan(j * n, n);
+
+            if (settings.filter == SmoothingFilter::OneEuro)
+                FilterOneEuro(ticks, channel, settings, output);
+            else
+                Convolve(channel, kernel, output);
+        });
+
+        for (std::size_t j = 0; j < valueCount; j++)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                // undo the unwrapping, so the angle stays in the range it was in
+                const auto unwrapOffset =
+                    values[j * n + i] - keyframes[i].value.GetByIndex(static_cast<uint32_t>(j));
+                result[i].SetByIndex(static_cast<uint32_t>(j), smoothed[j * n + i] - unwrapOffset);
+            }
+        }
+
+        return result;
+    }
+}  // namespace IWXMVM::MathUtils
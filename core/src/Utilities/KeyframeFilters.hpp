@@ -0,0 +1,37 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    enum class SmoothingFilter
+    {
+        Gaussian,
+        SavitzkyGolay,
+        OneEuro,
+    };
+
+    struct SmoothingSettings
+    {
+        SmoothingFilter filter = SmoothingFilter::Gaussian;
+
+        // Gaussian, in keyframes
+        float sigma = 3.0f;
+
+        // Savitzky-Golay, fits a polynomial to the 2 * radius + 1 keyframes around every keyframe
+        int32_t radius = 8;
+        int32_t polynomialOrder = 2;
+
+        // One-Euro, cutoff frequencies in Hz; beta scales how quickly the cutoff rises with the speed of a value
+        float minCutoff = 1.0f;
+        float beta = 0.01f;
+        float derivativeCutoff = 1.0f;
+    };
+
+    // Smoothes every value of the track, returning the new values in the order of the keyframes. Angles are
+    // unwrapped before filtering and each keyframe keeps the range its angles were in. Gaussian and Savitzky-Golay
+    // treat the keyframes as evenly spaced, which is what recorded tracks are; One-Euro takes the actual ticks into
+    // account.
+    std::vector<Types::KeyframeValue> SmoothKeyframes(const Types::KeyframeableProperty& property,
+                                                      const std::vector<Types::Keyframe>& keyframes,
+                                                      const SmoothingSettings& settings);
+}  // namespace IWXMVM::MathUtils
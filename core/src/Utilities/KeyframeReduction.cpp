@@ -0,0 +1,299 @@
+#include "StdInclude.hpp"
+#include "KeyframeReduction.hpp"
+
+#include "SegmentTable.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    namespace
+    {
+        bool IsAngle(Types::KeyframeValueType valueType, std::size_t valueIndex)
+        {
+            return valueType == Types::KeyframeValueType::CameraData && valueIndex >= 3 && valueIndex <= 5;
+        }
+
+        // Marks the keyframes of a single value that are needed to stay within the tolerance of straight lines
+        // between the kept keyframes. The first and the last keyframe have to be marked already.
+        void SimplifyValue(std::span<const float> ticks, std::span<const float> values, float tolerance,
+                           std::vector<char>& keep)
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> spans{{0, ticks.size() - 1}};
+            while (!spans.empty())
+            {
+                const auto [first, last] = spans.back();
+                spans.pop_back();
+
+                const auto length = ticks[last] - ticks[first];
+                float maxDistance = 0.0f;
+                std::size_t farthest = first;
+                for (std::size_t i = first + 1; i < last; i++)
+                {
+                    const auto s = length > 0.0f ? (ticks[i] - ticks[first]) / length : 0.0f;
+                    const auto distance = std::abs(values[i] - (values[first] + s * (values[last] - values[first])));
+                    if (distance > maxDistance)
+                    {
+                        maxDistance = distance;
+                        farthest = i;
+                    }
+                }
+
+                if (maxDistance > tolerance)
+                {
+                    keep[farthest] = 1;
+                    spans.push_back({first, farthest});
+                    spans.push_back({farthest, last});
+                }
+            }
+        }
+    }  // namespace
+
+    float GetDefaultReductionTolerance(const Types::KeyframeableProperty& property, uint32_t valueIndex)
+    {
+        if (property.valueType == Types::KeyframeValueType::CameraData)
+        {
+            // position in game units, angles and fov in degrees
+            return valueIndex < 3 ? 0.5f : 0.1f;
+        }
+
+        const auto [min, max] = property.defaultValueRange;
+        return (max - min) * 0.001f;
+    }
+
+    KeyframeReductionResult ReduceKeyframes(const Types::KeyframeableProperty& property,
+                                            const std::vector<Types::Keyframe>& keyframes,
+                                            std::span<const float> tolerances)
+    {
+        const auto n = keyframes.size();
+        const auto valueCount = static_cast<std::size_t>(property.GetValueCount());
+        assert(tolerances.size() >= valueCount);
+
+        KeyframeReductionResult result;
+        result.originalCount = n;
+        if (n < 3)
+            return result;
+
+        std::vector<float> ticks(n);
+        for (std::size_t i = 0; i < n; i++)
+            ticks[i] = static_cast<float>(keyframes[i].tick);
+
+        // values per channel, with angles unwrapped so that every key is within 180 degrees of the previous one
+        std::vector<std::vector<float>> values(valueCount, std::vector<float>(n));
+        for (std::size_t j = 0; j < valueCount; j++)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                auto value = keyframes[i].value.GetByIndex(static_cast<uint32_t>(j));
+                if (i > 0 && IsAngle(property.valueType, j))
+                    value += 360.0f * std::round((values[j][i - 1] - value) / 360.0f);
+                values[j][i] = value;
+            }
+        }
+
+        std::vector<std::vector<char>> valueKeep(valueCount, std::vector<char>(n, 0));
+        std::vector<std::size_t> valueIndices(valueCount);
+        std::iota(valueIndices.begin(), valueIndices.end(), 0);
+        std::for_each(std::execution::par, valueIndices.begin(), valueIndices.end(), [&](std::size_t j) {
+            valueKeep[j].front() = 1;
+            valueKeep[j].back() = 1;
+            SimplifyValue(ticks, values[j], tolerances[j], valueKeep[j]);
+        });
+
+        std::vector<char> keep(n, 0);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            // keyframes that change the interpolation are kept, so every remaining segment keeps its mode
+            const bool changesInterpolation = i > 0 && keyframes[i].interpolation != keyframes[i - 1].interpolation;
+            keep[i] = changesInterpolation ||
+                      std::any_of(valueKeep.begin(), valueKeep.end(), [i](const auto& k) { return k[i] != 0; });
+        }
+
+        // the candidates only consider straight lines, so check them against the interpolated curve and add back the
+        // worst offender between every two kept keyframes until nothing is out of tolerance anymore
+        std::vector<std::size_t> previousKept(n);
+        std::vector<std::size_t> nextKept(n);
+        for (std::size_t i = 0, previous = 0; i < n; i++)
+        {
+            if (!keep[i])
+                continue;
+            previousKept[i] = previous;
+            nextKept[previous] = i;
+            previous = i;
+        }
+        nextKept[n - 1] = n - 1;
+
+        // Writes the errors of the keyframe when the track has the given value at its tick, and returns the largest
+        // error relative to the tolerance of its value
+        auto GetErrors = [&](std::size_t i, const Types::KeyframeValue& value, std::span<float> errors) {
+            float ratio = 0.0f;
+            for (std::size_t j = 0; j < valueCount; j++)
+            {
+                auto error = value.GetByIndex(static_cast<uint32_t>(j)) -
+                             keyframes[i].value.GetByIndex(static_cast<uint32_t>(j));
+                if (IsAngle(property.valueType, j))
+                    error = std::remainder(error, 360.0f);
+                errors[j] = std::abs(error);
+                ratio = std::max(ratio, errors[j] / std::max(tolerances[j], 1e-6f));
+            }
+            return ratio;
+        };
+
+        // Removed keyframes only depend on the kept keyframes near them: linear and bezier segments on their ends,
+        // TCB segments and rotations on one more keyframe on either side, and cubic splines on all of them, with an
+        // influence that shrinks by a factor of about 2 - sqrt(3) per keyframe. So instead of compiling the whole
+        // reduced track, a span is checked against a track of the kept keyframes within this reach of it.
+        constexpr std::size_t REACH = 8;
+
+        // Finds the keyframe that is furthest out of tolerance in each of the given spans, which are identified by
+        // the kept keyframe they start at and have to be consecutive. All of them share one compiled part of the track.
+        auto CheckSpans = [&](std::span<const std::size_t> spans, std::span<std::optional<std::size_t>> worstIndices) {
+            auto windowFirst = spans.front();
+            auto windowLast = nextKept[spans.back()];
+            for (std::size_t r = 0; r < REACH; r++)
+            {
+                windowFirst = previousKept[windowFirst];
+                windowLast = nextKept[windowLast];
+            }
+
+            std::vector<Types::Keyframe> window;
+            for (auto i = windowFirst;; i = nextKept[i])
+            {
+                window.push_back(keyframes[i]);
+                if (i == windowLast)
+                    break;
+            }
+
+            SegmentTable segmentTable;
+            segmentTable.Compile(property, window);
+
+            std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT> spanErrors;
+            for (std::size_t k = 0; k < spans.size(); k++)
+            {
+                float worstRatio = 1.0f;
+                for (auto i = spans[k] + 1; i < nextKept[spans[k]]; i++)
+                {
+                    const auto ratio = GetErrors(i, segmentTable.Evaluate(ticks[i]), spanErrors);
+                    if (ratio > worstRatio)
+                    {
+                        worstRatio = ratio;
+                        worstIndices[k] = i;
+                    }
+                }
+            }
+        };
+
+        std::vector<std::size_t> dirtySpans;
+        std::vector<char> isDirty(n, 0);
+        auto MarkDirty = [&](std::size_t first) {
+            if (first != n - 1 && !isDirty[first])
+            {
+                isDirty[first] = 1;
+                dirtySpans.push_back(first);
+            }
+        };
+
+        // adding a keyframe changes the spans whose reach includes it
+        auto Keep = [&](std::size_t i) {
+            keep[i] = 1;
+            auto previous = i - 1;
+            while (!keep[previous])
+                previous--;
+            const auto next = nextKept[previous];
+            previousKept[i] = previous;
+            nextKept[i] = next;
+            nextKept[previous] = i;
+            previousKept[next] = i;
+
+            auto first = i;
+            for (std::size_t r = 0; r <= REACH + 1; r++, first = previousKept[first])
+                MarkDirty(first);
+            auto last = i;
+            for (std::size_t r = 0; r < REACH; r++)
+                MarkDirty(last = nextKept[last]);
+        };
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (keep[i])
+                MarkDirty(i);
+        }
+
+        std::vector<float> errors(n * valueCount);
+        std::vector<std::size_t> keyframeIndices(n);
+        std::iota(keyframeIndices.begin(), keyframeIndices.end(), 0);
+
+        while (!dirtySpans.empty())
+        {
+            while (!dirtySpans.empty())
+            {
+                // runs of consecutive spans are checked together, in chunks small enough to spread over all threads
+                constexpr std::size_t CHUNK_SIZE = 1024;
+                std::sort(dirtySpans.begin(), dirtySpans.end());
+                std::vector<std::pair<std::size_t, std::size_t>> chunks;
+                for (std::size_t k = 0; k < dirtySpans.size(); k++)
+                {
+                    const bool continuesChunk = k > 0 && nextKept[dirtySpans[k - 1]] == dirtySpans[k] &&
+                                                k - chunks.back().first < CHUNK_SIZE;
+                    if (continuesChunk)
+                        chunks.back().second++;
+                    else
+                        chunks.push_back({k, 1});
+                }
+
+                std::vector<std::optional<std::size_t>> worstIndices(dirtySpans.size());
+                std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](const auto& chunk) {
+                    const auto [offset, count] = chunk;
+                    CheckSpans(std::span(dirtySpans).subspan(offset, count),
+                               std::span(worstIndices).subspan(offset, count));
+                });
+
+                for (const auto first : dirtySpans)
+                    isDirty[first] = 0;
+                dirtySpans.clear();
+
+                for (const auto& worstIndex : worstIndices)
+                {
+                    if (worstIndex.has_value())
+                        Keep(*worstIndex);
+                }
+            }
+
+            // the reach leaves a tiny difference to the whole cubic spline, so the result is verified on the whole
+            // reduced track once, which also measures the final errors
+            std::vector<Types::Keyframe> reducedKeyframes;
+            for (std::size_t i = 0; i < n; i++)
+            {
+                if (keep[i])
+                    reducedKeyframes.push_back(keyframes[i]);
+            }
+
+            SegmentTable segmentTable;
+            segmentTable.Compile(property, reducedKeyframes);
+
+            std::vector<float> ratios(n);
+            std::for_each(std::execution::par, keyframeIndices.begin(), keyframeIndices.end(), [&](std::size_t i) {
+                const auto value = keep[i] ? keyframes[i].value : segmentTable.Evaluate(ticks[i]);
+                ratios[i] = GetErrors(i, value, std::span(errors).subspan(i * valueCount, valueCount));
+            });
+
+            for (std::size_t first = 0; first < n - 1;)
+            {
+                const auto last = nextKept[first];
+                const auto worst = std::max_element(ratios.begin() + first, ratios.begin() + last);
+                if (*worst > 1.0f)
+                    Keep(static_cast<std::size_t>(worst - ratios.begin()));
+                first = last;
+            }
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (!keep[i])
+                result.removedKeyframes.push_back(keyframes[i]);
+
+            for (std::size_t j = 0; j < valueCount; j++)
+                result.maxErrors[j] = std::max(result.maxErrors[j], errors[i * valueCount + j]);
+        }
+
+        return result;
+    }
+}  // namespace IWXMVM::MathUtils
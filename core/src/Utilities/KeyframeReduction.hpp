@@ -0,0 +1,25 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    struct KeyframeReductionResult
+    {
+        std::vector<Types::Keyframe> removedKeyframes;
+        std::size_t originalCount = 0;
+
+        // largest deviation of the reduced track from every original keyframe, per value
+        std::array<float, Types::KeyframeInterpolation::MAX_VALUE_COUNT> maxErrors{};
+    };
+
+    float GetDefaultReductionTolerance(const Types::KeyframeableProperty& property, uint32_t valueIndex);
+
+    // Removes keyframes that the rest of the track already reproduces within the given tolerance (one per value).
+    // Candidates are picked per value with the Ramer-Douglas-Peucker algorithm, in parallel, after which keyframes are
+    // added back until the actual interpolated curve stays within the tolerance everywhere. Adding a keyframe only
+    // rechecks the spans near it, against a compiled part of the track around them; the whole reduced track is only
+    // compiled to verify the result.
+    KeyframeReductionResult ReduceKeyframes(const Types::KeyframeableProperty& property,
+                                            const std::vector<Types::Keyframe>& keyframes,
+                                            std::span<const float> tolerances);
+}  // namespace IWXMVM::MathUtils
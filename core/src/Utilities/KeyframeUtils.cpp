@@ -0,0 +1,49 @@
+#include "StdInclude.hpp"
+#include "KeyframeUtils.hpp"
+
+namespace IWXMVM::KeyframeUtils
+{
+    void BuildSlotIndex(const std::vector<Types::Keyframe>& track, SlotIndex& index)
+    {
+        index.clear();
+        index.reserve(track.size());
+        for (std::size_t i = 0; i < track.size(); i++)
+        {
+            index[track[i].id] = i;
+        }
+    }
+
+    void AppendKeyframes(std::vector<Types::Keyframe>& track, std::span<const Types::Keyframe> keyframes,
+                         SlotIndex& index)
+    {
+        track.reserve(track.size() + keyframes.size());
+        for (const auto& keyframe : keyframes)
+        {
+            index[keyframe.id] = track.size();
+            track.emplace_back(keyframe);
+        }
+    }
+
+    void EraseKeyframes(std::vector<Types::Keyframe>& track, std::span<const Types::Keyframe> keyframes)
+    {
+        // looking up and erasing the keyframes one by one would be quadratic when removing large selections
+        std::unordered_set<int32_t> idsToErase;
+        idsToErase.reserve(keyframes.size());
+        for (const auto& keyframe : keyframes)
+        {
+            idsToErase.insert(keyframe.id);
+        }
+
+        std::erase_if(track, [&](const Types::Keyframe& k) { return idsToErase.contains(k.id); });
+    }
+
+    bool SortByTick(std::vector<Types::Keyframe>& track)
+    {
+        const auto byTick = [](const auto& a, const auto& b) { return a.tick < b.tick; };
+        if (std::is_sorted(track.begin(), track.end(), byTick))
+            return false;
+
+        std::stable_sort(track.begin(), track.end(), byTick);
+        return true;
+    }
+}  // namespace IWXMVM::KeyframeUtils
@@ -0,0 +1,21 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::KeyframeUtils
+{
+    // Maps keyframe ids to their position in a track
+    using SlotIndex = std::unordered_map<int32_t, std::size_t>;
+
+    void BuildSlotIndex(const std::vector<Types::Keyframe>& track, SlotIndex& index);
+
+    // Appends the keyframes to the end of the track and adds them to its index, which is expected to be up to date
+    void AppendKeyframes(std::vector<Types::Keyframe>& track, std::span<const Types::Keyframe> keyframes,
+                         SlotIndex& index);
+
+    // Erases the keyframes with the same ids from the track in a single pass. Positions change, so the track's index
+    // has to be rebuilt afterwards.
+    void EraseKeyframes(std::vector<Types::Keyframe>& track, std::span<const Types::Keyframe> keyframes);
+
+    // Stable, so that keyframes on the same tick keep their order. Returns whether the track had to be reordered.
+    bool SortByTick(std::vector<Types::Keyframe>& track);
+}  // namespace IWXMVM::KeyframeUtils
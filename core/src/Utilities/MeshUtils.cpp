@@ -0,0 +1,95 @@
+#include "StdInclude.hpp"
+#include "MeshUtils.hpp"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "tiny_obj_loader.h"
+
+namespace std
+{
+    template <>
+    struct hash<IWXMVM::Types::Vertex>
+    {
+        size_t operator()(IWXMVM::Types::Vertex const& vertex) const
+        {
+            return ((hash<glm::vec3>()(vertex.pos) ^ (hash<glm::vec3>()(vertex.normal) << 1)) >> 1) ^
+                   (hash<D3DCOLOR>()(vertex.col) << 1);
+        }
+    };
+}  // namespace std
+
+namespace IWXMVM::MeshUtils
+{
+    bool LoadObj(std::string_view data, std::vector<Types::Vertex>& vertices, std::vector<Types::Index>& indices,
+                 std::string& warning, std::string& error)
+    {
+        tinyobj::ObjReader reader;
+
+        if (!reader.ParseFromString(std::string(data), ""))
+        {
+            error = reader.Error();
+            return false;
+        }
+
+        warning = reader.Warning();
+
+        auto& attrib = reader.GetAttrib();
+        auto& shapes = reader.GetShapes();
+
+        vertices.reserve(attrib.vertices.size() / 3);
+
+        // Loop over shapes
+        std::unordered_map<Types::Vertex, std::uint32_t> uniqueVertices;
+        uniqueVertices.reserve(attrib.vertices.size() / 3);
+        for (const auto& shape : shapes)
+        {
+            for (const auto& index : shape.mesh.indices)
+            {
+                Types::Vertex vertex = {};
+                vertex.pos = {
+                    attrib.vertices[index.vertex_index * 3 + 0],
+                    attrib.vertices[index.vertex_index * 3 + 1],
+                    attrib.vertices[index.vertex_index * 3 + 2],
+                };
+                vertex.normal = {
+                    attrib.normals[index.normal_index * 3 + 0],
+                    attrib.normals[index.normal_index * 3 + 1],
+                    attrib.normals[index.normal_index * 3 + 2],
+                };
+                vertex.col = D3DCOLOR_COLORVALUE(attrib.colors[index.vertex_index * 3 + 0],
+                                                 attrib.colors[index.vertex_index * 3 + 1],
+                                                 attrib.colors[index.vertex_index * 3 + 2], 1.0f);
+
+                const auto [it, isNew] =
+                    uniqueVertices.try_emplace(vertex, static_cast<std::uint32_t>(vertices.size()));
+                if (isNew)
+                    vertices.push_back(vertex);
+
+                indices.push_back(it->second);
+            }
+        }
+
+        return true;
+    }
+
+    bool IntersectsRay(std::span<const Types::Vertex> vertices, std::span<const Types::Index> indices,
+                       const glm::mat4& model, glm::vec3 origin, glm::vec3 direction)
+    {
+        direction = glm::normalize(direction);
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const auto a = glm::vec3(model * glm::vec4(vertices[indices[i]].pos, 1.0f));
+            const auto b = glm::vec3(model * glm::vec4(vertices[indices[i + 1]].pos, 1.0f));
+            const auto c = glm::vec3(model * glm::vec4(vertices[indices[i + 2]].pos, 1.0f));
+
+            glm::vec2 baryPosition;
+            float distance = 0;
+            if (glm::intersectRayTriangle(origin, direction, a, b, c, baryPosition, distance))
+                return true;
+        }
+        return false;
+    }
+}  // namespace IWXMVM::MeshUtils
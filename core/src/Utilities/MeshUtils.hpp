@@ -0,0 +1,14 @@
+#pragma once
+#include "Types/Vertex.hpp"
+
+namespace IWXMVM::MeshUtils
+{
+    // Parses a Wavefront OBJ file into a triangle list in which every distinct vertex is stored once. Returns false and
+    // sets error if the file can't be parsed, warning is set either way.
+    bool LoadObj(std::string_view data, std::vector<Types::Vertex>& vertices, std::vector<Types::Index>& indices,
+                 std::string& warning, std::string& error);
+
+    // Whether a ray hits any triangle of a mesh that is placed in the world by model
+    bool IntersectsRay(std::span<const Types::Vertex> vertices, std::span<const Types::Index> indices,
+                       const glm::mat4& model, glm::vec3 origin, glm::vec3 direction);
+}  // namespace IWXMVM::MeshUtils
@@ -0,0 +1,32 @@
+#include "StdInclude.hpp"
+#include "NaturalSort.hpp"
+
+#include "Utilities/Profiler.hpp"
+
+namespace IWXMVM::NaturalSort
+{
+    void SortDemoPaths(std::span<std::filesystem::path> demos, std::size_t extensionLength)
+    {
+        PROFILE_FUNCTION();
+
+        if (demos.empty())
+            return;
+
+        const std::size_t dirLength = demos.front().parent_path().native().length();
+        std::sort(demos.begin(), demos.end(), [&](const auto& lhs, const auto& rhs) {
+            const std::size_t lhsLength = lhs.native().length();
+            const std::size_t rhsLength = rhs.native().length();
+
+            assert(lhsLength > dirLength + extensionLength + 1 && rhsLength > dirLength + extensionLength + 1);
+
+            const auto* lhsFileNamePtr = lhs.c_str() + dirLength + 1;
+            const auto* rhsFileNamePtr = rhs.c_str() + dirLength + 1;
+            const std::size_t lhsSvLength = lhsLength - dirLength - extensionLength - 1;
+            const std::size_t rhsSvLength = rhsLength - dirLength - extensionLength - 1;
+
+            using StringView = std::basic_string_view<std::filesystem::path::value_type>;
+            return CompareNaturally<false>(StringView{lhsFileNamePtr, lhsSvLength},
+                                           StringView{rhsFileNamePtr, rhsSvLength});
+        });
+    }
+}  // namespace IWXMVM::NaturalSort
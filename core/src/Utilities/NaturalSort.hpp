@@ -0,0 +1,71 @@
+#pragma once
+
+namespace IWXMVM::NaturalSort
+{
+    // Orders strings like a person would, comparing runs of digits by their value: "demo2" comes before "demo10"
+    template <bool caseSensitive, typename T>
+        requires std::is_same_v<T, std::string_view> || std::is_same_v<T, std::wstring_view>
+    bool CompareNaturally(const T lhs, const T rhs)
+    {
+        auto IsDigit = [](auto c) { return std::iswdigit(c); };
+
+        auto ToUpper = [](auto c) {
+            if constexpr (caseSensitive)
+                return c;
+            else
+                return std::towupper(c);
+        };
+
+        auto StringToUint = [](const auto* str, auto* output, std::size_t* endPtr = nullptr) {
+            try
+            {
+                *output = std::stoull(str, endPtr);
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        };
+
+        for (auto lhsItr = lhs.begin(), rhsItr = rhs.begin(); lhsItr != lhs.end() && rhsItr != rhs.end();)
+        {
+            if (IsDigit(*lhsItr) && IsDigit(*rhsItr))
+            {
+                std::uint64_t lhsNum = 0;
+                std::uint64_t rhsNum = 0;
+                std::size_t lhsDigitCount = 0;
+                std::size_t rhsDigitCount = 0;
+
+                // when sorting a container, move the 'unparsable' string_view to end of container if string-to-uint
+                // throws an exception
+                if (!StringToUint(std::addressof(*lhsItr), &lhsNum, &lhsDigitCount))
+                    return false;
+                if (!StringToUint(std::addressof(*rhsItr), &rhsNum, &rhsDigitCount))
+                    return true;
+
+                if (lhsNum != rhsNum)
+                    return lhsNum < rhsNum;
+
+                assert(lhsDigitCount == std::distance(lhsItr, std::find_if_not(lhsItr, lhs.end(), IsDigit)));
+                assert(rhsDigitCount == std::distance(rhsItr, std::find_if_not(rhsItr, rhs.end(), IsDigit)));
+
+                lhsItr += lhsDigitCount;
+                rhsItr += rhsDigitCount;
+            }
+            else
+            {
+                if (ToUpper(*lhsItr) != ToUpper(*rhsItr))
+                    return *lhsItr < *rhsItr;
+
+                ++lhsItr;
+                ++rhsItr;
+            }
+        }
+
+        return lhs.length() < rhs.length();
+    }
+
+    // Sorts the demos of one directory naturally by their file name, without the extension
+    void SortDemoPaths(std::span<std::filesystem::path> demos, std::size_t extensionLength);
+}  // namespace IWXMVM::NaturalSort
@@ -0,0 +1,215 @@
+#include "StdInclude.hpp"
+#include "PatternScanner.hpp"
+
+namespace IWXMVM::Signatures
+{
+    namespace
+    {
+        // every signature in the tree fits into two vectors, longer ones are verified byte by byte
+        constexpr std::size_t VECTOR_PATTERN_LENGTH = 32;
+
+        // the byte histogram that picks the anchors is built from every n-th byte of the image
+        constexpr std::size_t HISTOGRAM_STRIDE = 61;
+
+        // images are split into ranges of this size for scanning them in parallel
+        constexpr std::size_t SCAN_RANGE_SIZE = 1024 * 1024;
+
+        struct CompiledPattern
+        {
+            std::size_t length;
+            std::size_t anchor;  // position of the rarest non-masked byte
+            std::uint8_t anchorValue;
+
+            // masked bytes are 0 in values and 0xFF in mask, so a candidate matches when (candidate == values) | mask
+            // is all ones
+            alignas(16) std::array<std::uint8_t, VECTOR_PATTERN_LENGTH> values;
+            alignas(16) std::array<std::uint8_t, VECTOR_PATTERN_LENGTH> mask;
+        };
+
+        CompiledPattern CompilePattern(const ScanPattern& pattern, const std::array<std::size_t, 256>& histogram)
+        {
+            CompiledPattern compiled{pattern.bytes.size(), 0, 0, {}, {}};
+            compiled.mask.fill(0xFF);
+
+            auto anchorFrequency = (std::numeric_limits<std::size_t>::max)();
+            for (std::size_t i = 0; i < pattern.bytes.size(); i++)
+            {
+                if (pattern.bytes[i] == maskValue)
+                    continue;
+
+                const auto value = static_cast<std::uint8_t>(pattern.bytes[i]);
+                if (i < VECTOR_PATTERN_LENGTH)
+                {
+                    compiled.values[i] = value;
+                    compiled.mask[i] = 0;
+                }
+
+                if (histogram[value] < anchorFrequency)
+                {
+                    anchorFrequency = histogram[value];
+                    compiled.anchor = i;
+                    compiled.anchorValue = value;
+                }
+            }
+
+            return compiled;
+        }
+
+        bool Matches(const CompiledPattern& compiled, const ScanPattern& pattern, const std::uint8_t* start,
+                     const std::uint8_t* end)
+        {
+            if (compiled.length <= VECTOR_PATTERN_LENGTH && start + VECTOR_PATTERN_LENGTH <= end)
+            {
+                for (std::size_t i = 0; i < VECTOR_PATTERN_LENGTH; i += 16)
+                {
+                    const auto candidate = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + i));
+                    const auto values = _mm_load_si128(reinterpret_cast<const __m128i*>(compiled.values.data() + i));
+                    const auto mask = _mm_load_si128(reinterpret_cast<const __m128i*>(compiled.mask.data() + i));
+                    if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(candidate, values), mask)) != 0xFFFF)
+                        return false;
+                }
+                return true;
+            }
+
+            for (std::size_t i = pattern.frontMaskCount; i < compiled.length; i++)
+            {
+                if (pattern.bytes[i] != maskValue && pattern.bytes[i] != start[i])
+                    return false;
+            }
+            return true;
+        }
+
+        // Finds the first match of every pattern that starts in [rangeBegin, rangeEnd). Every pattern is anchored on
+        // its rarest byte: 16 bytes at a time are compared against all anchor bytes at once, and only the positions
+        // that hit one of them are verified.
+        std::vector<const std::uint8_t*> ScanRange(std::span<const std::uint8_t> image,
+                                                   std::span<const ScanPattern> patterns,
+                                                   std::span<const CompiledPattern> compiledPatterns,
+                                                   const std::uint8_t* rangeBegin, const std::uint8_t* rangeEnd)
+        {
+            const auto* imageEnd = image.data() + image.size();
+            std::vector<const std::uint8_t*> matches(patterns.size(), nullptr);
+
+            std::array<std::vector<std::size_t>, 256> patternsByAnchor;
+            std::size_t maxLength = 0;
+            for (std::size_t i = 0; i < compiledPatterns.size(); i++)
+            {
+                patternsByAnchor[compiledPatterns[i].anchorValue].push_back(i);
+                maxLength = std::max(maxLength, compiledPatterns[i].length);
+            }
+
+            std::vector<__m128i> anchors;
+            auto UpdateAnchors = [&]() {
+                anchors.clear();
+                for (std::size_t value = 0; value < patternsByAnchor.size(); value++)
+                {
+                    if (!patternsByAnchor[value].empty())
+                        anchors.push_back(_mm_set1_epi8(static_cast<char>(value)));
+                }
+            };
+            UpdateAnchors();
+
+            auto CheckCandidates = [&](const std::uint8_t* position) {
+                auto& candidates = patternsByAnchor[*position];
+                const auto previousCount = candidates.size();
+
+                std::erase_if(candidates, [&](std::size_t patternIndex) {
+                    const auto& compiled = compiledPatterns[patternIndex];
+
+                    // matches that start in the previous range are found there
+                    if (position < rangeBegin + compiled.anchor)
+                        return false;
+
+                    const auto* start = position - compiled.anchor;
+                    if (start >= rangeEnd || start + compiled.length > imageEnd ||
+                        !Matches(compiled, patterns[patternIndex], start, imageEnd))
+                        return false;
+
+                    matches[patternIndex] = start;
+                    return true;
+                });
+
+                // anchors whose patterns have all been found are no longer searched for
+                if (candidates.empty() && previousCount > 0)
+                    UpdateAnchors();
+            };
+
+            // anchors of matches that start at the end of the range can lie past it
+            const auto* scanEnd = rangeEnd + std::min(maxLength, static_cast<std::size_t>(imageEnd - rangeEnd));
+
+            const auto* position = rangeBegin;
+            for (; position + 16 <= scanEnd && !anchors.empty(); position += 16)
+            {
+                const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+
+                auto hits = _mm_setzero_si128();
+                for (const auto& anchor : anchors)
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, anchor));
+
+                auto hitMask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+                while (hitMask != 0)
+                {
+                    CheckCandidates(position + std::countr_zero(hitMask));
+                    hitMask &= hitMask - 1;
+                }
+            }
+
+            for (; position < scanEnd && !anchors.empty(); position++)
+                CheckCandidates(position);
+
+            return matches;
+        }
+    }  // namespace
+
+    bool MatchesAt(const ScanPattern& pattern, std::span<const std::uint8_t> image, const std::uint8_t* start)
+    {
+        if (start < image.data() || start + pattern.bytes.size() > image.data() + image.size())
+            return false;
+
+        for (std::size_t i = pattern.frontMaskCount; i < pattern.bytes.size(); i++)
+        {
+            if (pattern.bytes[i] != maskValue && pattern.bytes[i] != start[i])
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<const std::uint8_t*> ScanForPatterns(std::span<const std::uint8_t> image,
+                                                     std::span<const ScanPattern> patterns)
+    {
+        std::array<std::size_t, 256> histogram{};
+        for (std::size_t i = 0; i < image.size(); i += HISTOGRAM_STRIDE)
+            histogram[image[i]]++;
+
+        std::vector<CompiledPattern> compiledPatterns;
+        compiledPatterns.reserve(patterns.size());
+        for (const auto& pattern : patterns)
+            compiledPatterns.push_back(CompilePattern(pattern, histogram));
+
+        // the first match of every pattern is taken from the earliest range that has one
+        std::vector<std::vector<const std::uint8_t*>> rangeMatches((image.size() + SCAN_RANGE_SIZE - 1) /
+                                                                   SCAN_RANGE_SIZE);
+        std::vector<std::size_t> rangeIndices(rangeMatches.size());
+        std::iota(rangeIndices.begin(), rangeIndices.end(), 0);
+
+        std::for_each(std::execution::par, rangeIndices.begin(), rangeIndices.end(), [&](std::size_t i) {
+            const auto* rangeBegin = image.data() + i * SCAN_RANGE_SIZE;
+            const auto* rangeEnd = image.data() + std::min((i + 1) * SCAN_RANGE_SIZE, image.size());
+            rangeMatches[i] = ScanRange(image, patterns, compiledPatterns, rangeBegin, rangeEnd);
+        });
+
+        std::vector<const std::uint8_t*> matches(patterns.size(), nullptr);
+        for (std::size_t i = 0; i < patterns.size(); i++)
+        {
+            for (const auto& range : rangeMatches)
+            {
+                if (range[i] != nullptr)
+                {
+                    matches[i] = range[i];
+                    break;
+                }
+            }
+        }
+        return matches;
+    }
+}  // namespace IWXMVM::Signatures
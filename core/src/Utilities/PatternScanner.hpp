@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace IWXMVM::Signatures
+{
+    // value of a masked byte in a signature, which matches any byte
+    inline constexpr std::uint16_t maskValue = UINT8_MAX + 1;
+
+    struct ScanPattern
+    {
+        std::span<const std::uint16_t> bytes;
+        std::size_t frontMaskCount;
+    };
+
+    bool MatchesAt(const ScanPattern& pattern, std::span<const std::uint8_t> image, const std::uint8_t* start);
+
+    // Finds the first match of every pattern in the image, nullptr for patterns that don't occur. The image is
+    // scanned once for all patterns, split into ranges that are scanned in parallel. Only depends on the standard
+    // library and SSE2, so it can be built and benchmarked without the game.
+    std::vector<const std::uint8_t*> ScanForPatterns(std::span<const std::uint8_t> image,
+                                                     std::span<const ScanPattern> patterns);
+}  // namespace IWXMVM::Signatures
@@ -0,0 +1,173 @@
+#include "StdInclude.hpp"
+#include "Profiler.hpp"
+
+#include "nlohmann/json.hpp"
+
+namespace IWXMVM::Profiler
+{
+    constexpr uint32_t THREAD_BUFFER_SIZE = 1 << 14;
+    constexpr std::size_t HISTORY_FRAME_COUNT = 600;
+
+    // Written only by its thread and read only by the render thread, zones that don't fit until the next frame are
+    // dropped
+    struct ThreadBuffer
+    {
+        std::array<ZoneRecord, THREAD_BUFFER_SIZE> records;
+        std::atomic<uint32_t> writeIndex = 0;
+        std::atomic<uint32_t> readIndex = 0;
+        std::atomic<uint32_t> droppedCount = 0;
+        uint32_t threadId;
+    };
+
+    std::mutex threadBuffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    thread_local ThreadBuffer* threadBuffer = nullptr;
+    thread_local uint32_t threadDepth = 0;
+
+    std::array<FrameRecord, HISTORY_FRAME_COUNT> history;
+    std::size_t historyIndex = 0;
+    std::size_t historyCount = 0;
+    uint64_t frameStart = 0;
+    uint32_t renderThreadId = 0;
+
+    const uint64_t calibrationTicks = __rdtsc();
+    const auto calibrationTime = std::chrono::steady_clock::now();
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        if (threadBuffer == nullptr)
+        {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = GetCurrentThreadId();
+            threadBuffer = buffer.get();
+
+            std::lock_guard lock(threadBuffersMutex);
+            threadBuffers.push_back(std::move(buffer));
+        }
+        return *threadBuffer;
+    }
+
+    Zone::Zone(const char* name, uint32_t line, uint64_t* elapsedTicks)
+        : name(name), line(line), depth(threadDepth++), start(__rdtsc()), elapsedTicks(elapsedTicks)
+    {
+    }
+
+    Zone::~Zone()
+    {
+        const auto end = __rdtsc();
+        threadDepth--;
+
+        if (elapsedTicks != nullptr)
+            *elapsedTicks = end - start;
+
+        auto& buffer = GetThreadBuffer();
+        const auto writeIndex = buffer.writeIndex.load(std::memory_order_relaxed);
+        if (writeIndex - buffer.readIndex.load(std::memory_order_acquire) >= THREAD_BUFFER_SIZE)
+        {
+            buffer.droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.records[writeIndex % THREAD_BUFFER_SIZE] = {name, line, buffer.threadId, depth, start, end};
+        buffer.writeIndex.store(writeIndex + 1, std::memory_order_release);
+    }
+
+    void NewFrame()
+    {
+        const auto now = __rdtsc();
+        renderThreadId = GetCurrentThreadId();
+
+        auto& frame = history[historyIndex];
+        frame.start = frameStart != 0 ? frameStart : calibrationTicks;
+        frame.end = now;
+        frame.zones.clear();
+
+        {
+            std::lock_guard lock(threadBuffersMutex);
+            for (const auto& buffer : threadBuffers)
+            {
+                const auto readIndex = buffer->readIndex.load(std::memory_order_relaxed);
+                const auto writeIndex = buffer->writeIndex.load(std::memory_order_acquire);
+                for (auto i = readIndex; i != writeIndex; i++)
+                    frame.zones.push_back(buffer->records[i % THREAD_BUFFER_SIZE]);
+                buffer->readIndex.store(writeIndex, std::memory_order_release);
+
+                if (const auto droppedCount = buffer->droppedCount.exchange(0); droppedCount > 0)
+                    LOG_WARN("Profiler dropped {} zones of thread {}", droppedCount, buffer->threadId);
+            }
+        }
+
+        frameStart = now;
+        historyIndex = (historyIndex + 1) % HISTORY_FRAME_COUNT;
+        historyCount = std::min(historyCount + 1, HISTORY_FRAME_COUNT);
+    }
+
+    const FrameRecord& GetLastFrame()
+    {
+        static const FrameRecord emptyFrame;
+        if (historyCount == 0)
+            return emptyFrame;
+        return history[(historyIndex + HISTORY_FRAME_COUNT - 1) % HISTORY_FRAME_COUNT];
+    }
+
+    double TicksToMilliseconds(uint64_t ticks)
+    {
+        // the TSC runs at a constant rate on all CPUs this game runs on, it's measured once enough time has passed
+        static double ticksPerMillisecond = 0.0;
+        if (ticksPerMillisecond == 0.0)
+        {
+            const auto elapsedTicks = __rdtsc() - calibrationTicks;
+            const auto elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                               calibrationTime).count();
+            if (elapsedTime < 1000.0)
+                return static_cast<double>(ticks) / (static_cast<double>(elapsedTicks) / elapsedTime);
+            ticksPerMillisecond = static_cast<double>(elapsedTicks) / elapsedTime;
+        }
+        return static_cast<double>(ticks) / ticksPerMillisecond;
+    }
+
+    bool ExportChromeTrace(const std::filesystem::path& path)
+    {
+        auto GetTimestamp = [](uint64_t ticks) {
+            return TicksToMilliseconds(ticks > calibrationTicks ? ticks - calibrationTicks : 0) * 1000.0;
+        };
+
+        auto events = nlohmann::json::array();
+        for (std::size_t i = 0; i < historyCount; i++)
+        {
+            const auto& frame = history[(historyIndex + HISTORY_FRAME_COUNT - historyCount + i) % HISTORY_FRAME_COUNT];
+            events.push_back({{"name", "Frame"},
+                              {"ph", "X"},
+                              {"ts", GetTimestamp(frame.start)},
+                              {"dur", TicksToMilliseconds(frame.end - frame.start) * 1000.0},
+                              {"pid", 0},
+                              {"tid", renderThreadId}});
+
+            for (const auto& zone : frame.zones)
+            {
+                auto name = std::string(zone.name);
+                if (zone.line != 0)
+                    name += ":" + std::to_string(zone.line);
+
+                events.push_back({{"name", std::move(name)},
+                                  {"ph", "X"},
+                                  {"ts", GetTimestamp(zone.start)},
+                                  {"dur", TicksToMilliseconds(zone.end - zone.start) * 1000.0},
+                                  {"pid", 0},
+                                  {"tid", zone.threadId}});
+            }
+        }
+
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Failed to open {} for writing", path.string());
+            return false;
+        }
+
+        file << nlohmann::json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}}.dump();
+        LOG_INFO("Exported {} profiled frames to {}", historyCount, path.string());
+        return true;
+    }
+}  // namespace IWXMVM::Profiler
@@ -0,0 +1,65 @@
+#pragma once
+
+// Zones can be placed anywhere in core and game code, they are compiled out if IWXMVM_DISABLE_PROFILER is defined
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifndef IWXMVM_DISABLE_PROFILER
+#define PROFILE_ZONE(...) const ::IWXMVM::Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__)(__VA_ARGS__)
+#else
+#define PROFILE_ZONE(...)
+#endif
+
+#define PROFILE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+
+namespace IWXMVM::Profiler
+{
+    // Zone names must outlive the profiler, which in practice means string literals
+    struct ZoneRecord
+    {
+        const char* name;
+        uint32_t line;  // shown next to the name if not 0
+        uint32_t threadId;
+        uint32_t depth;
+        uint64_t start;  // in TSC ticks
+        uint64_t end;
+    };
+
+    struct FrameRecord
+    {
+        uint64_t start = 0;
+        uint64_t end = 0;
+        std::vector<ZoneRecord> zones;  // in the order they ended
+    };
+
+    // Measures the time between its construction and destruction with the TSC. Finished zones are written to a buffer
+    // of the calling thread without locking, and are collected by the render thread in NewFrame. The duration is also
+    // written to elapsedTicks if given, for callers that keep their own statistics.
+    class Zone
+    {
+       public:
+        explicit Zone(const char* name, uint32_t line = 0, uint64_t* elapsedTicks = nullptr);
+        ~Zone();
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+       private:
+        const char* name;
+        uint32_t line;
+        uint32_t depth;
+        uint64_t start;
+        uint64_t* elapsedTicks;
+    };
+
+    // Called once per presented frame from the render thread, ends the current frame
+    void NewFrame();
+
+    // Render thread only; the returned frame is valid until the next call to NewFrame
+    const FrameRecord& GetLastFrame();
+
+    double TicksToMilliseconds(uint64_t ticks);
+
+    // Writes the recorded history of the last few seconds in Chrome's trace event format
+    bool ExportChromeTrace(const std::filesystem::path& path);
+}  // namespace IWXMVM::Profiler
@@ -0,0 +1,125 @@
+#include "StdInclude.hpp"
+#include "RotationSpline.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    glm::quat QuaternionFromAngles(glm::vec3 angles)
+    {
+        // the game builds its view axis as yaw (around z), then pitch (around y), then roll (around x)
+        const auto radians = glm::radians(angles);
+        return glm::angleAxis(radians[1], glm::vector3::up) * glm::angleAxis(radians[0], glm::vector3::right) *
+               glm::angleAxis(radians[2], glm::vector3::forward);
+    }
+
+    glm::vec3 AnglesFromQuaternion(glm::quat rotation)
+    {
+        const auto m = glm::mat3_cast(rotation);
+        const auto pitch = std::asin(-glm::clamp(m[0][2], -1.0f, 1.0f));
+        const auto yaw = std::atan2(m[0][1], m[0][0]);
+        const auto roll = std::atan2(m[1][2], m[2][2]);
+        return glm::degrees(glm::vec3(pitch, yaw, roll));
+    }
+
+    void RotationSpline::Build(const std::vector<Types::Keyframe>& keyframes,
+                               std::span<const Types::KeyframeInterpolationMode> segmentModes)
+    {
+        const auto n = keyframes.size();
+
+        ticks.resize(n);
+        rotations.resize(n);
+        outgoingControlPoints.resize(n);
+        incomingControlPoints.resize(n);
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            ticks[i] = static_cast<float>(keyframes[i].tick);
+            rotations[i] = QuaternionFromAngles(keyframes[i].value.cameraData.rotation);
+
+            // q and -q describe the same rotation, pick the one closer to the previous key
+            if (i > 0 && glm::dot(rotations[i - 1], rotations[i]) < 0.0f)
+                rotations[i] = -rotations[i];
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (i == 0 || i == n - 1)
+            {
+                outgoingControlPoints[i] = rotations[i];
+                incomingControlPoints[i] = rotations[i];
+                continue;
+            }
+
+            // glm::intermediate assumes segments of equal length. Here the tangent is the central difference over
+            // both neighbouring segments, scaled to the length of the segment it is used in, so the angular velocity
+            // per tick stays continuous across keys with uneven spacing.
+            const auto inverse = glm::inverse(rotations[i]);
+            const auto toNext = glm::log(rotations[i + 1] * inverse);
+            const auto toPrevious = glm::log(rotations[i - 1] * inverse);
+
+            const auto previousLength = ticks[i] - ticks[i - 1];
+            const auto nextLength = ticks[i + 1] - ticks[i];
+            const auto totalLength = previousLength + nextLength;
+            const auto nextWeight = totalLength > 0.0f ? nextLength / totalLength : 0.5f;
+
+            const auto outgoingTangent = (toNext - toPrevious) * nextWeight;
+            const auto incomingTangent = (toNext - toPrevious) * (1.0f - nextWeight);
+            outgoingControlPoints[i] = glm::exp((outgoingTangent - toNext) * 0.5f) * rotations[i];
+            incomingControlPoints[i] = glm::exp((toPrevious + incomingTangent) * -0.5f) * rotations[i];
+        }
+
+        // squad with the keys themselves as control points is a slerp
+        for (std::size_t i = 0; i < segmentModes.size() && i + 1 < n; i++)
+        {
+            if (segmentModes[i] != Types::KeyframeInterpolationMode::Linear)
+                continue;
+
+            outgoingControlPoints[i] = rotations[i];
+            incomingControlPoints[i + 1] = rotations[i + 1];
+        }
+    }
+
+    std::pair<std::size_t, float> RotationSpline::FindSegment(float tick) const
+    {
+        assert(ticks.size() > 1 && tick > ticks.front() && tick < ticks.back());
+
+        const auto next = std::upper_bound(ticks.begin(), ticks.end(), tick);
+        const auto i = static_cast<std::size_t>(std::distance(ticks.begin(), next)) - 1;
+
+        const auto segmentLength = ticks[i + 1] - ticks[i];
+        return {i, segmentLength > 0.0f ? (tick - ticks[i]) / segmentLength : 0.0f};
+    }
+
+    glm::vec3 RotationSpline::Evaluate(float tick) const
+    {
+        assert(!IsEmpty());
+
+        if (ticks.size() == 1 || tick <= ticks.front())
+            return AnglesFromQuaternion(rotations.front());
+        if (tick >= ticks.back())
+            return AnglesFromQuaternion(rotations.back());
+
+        const auto [i, t] = FindSegment(tick);
+        return EvaluateSegment(i, t);
+    }
+
+    glm::vec3 RotationSpline::EvaluateSegment(std::size_t segment, float t) const
+    {
+        assert(segment + 1 < rotations.size());
+
+        return AnglesFromQuaternion(glm::squad(rotations[segment], rotations[segment + 1],
+                                               outgoingControlPoints[segment], incomingControlPoints[segment + 1], t));
+    }
+
+    glm::vec3 RotationSpline::EvaluateLinear(float tick) const
+    {
+        assert(!IsEmpty());
+
+        if (ticks.size() == 1 || tick <= ticks.front())
+            return AnglesFromQuaternion(rotations.front());
+        if (tick >= ticks.back())
+            return AnglesFromQuaternion(rotations.back());
+
+        const auto [i, t] = FindSegment(tick);
+        return AnglesFromQuaternion(glm::slerp(rotations[i], rotations[i + 1], t));
+    }
+}  // namespace IWXMVM::MathUtils
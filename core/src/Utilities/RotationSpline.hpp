@@ -0,0 +1,39 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    glm::quat QuaternionFromAngles(glm::vec3 angles);
+    glm::vec3 AnglesFromQuaternion(glm::quat rotation);
+
+    // Smooth rotation track for camera keyframes. Keyframe rotations are converted to quaternions once when the track
+    // is built, with each one flipped into the hemisphere of its predecessor so that every segment takes the shortest
+    // arc. The squad control points of every segment are precomputed as well, leaving only the slerps for Evaluate.
+    // Keys get separate control points for the segments before and after them, since those can differ in length.
+    // Owned by SegmentTable, which is recompiled whenever the keyframes revision of its property changes.
+    class RotationSpline
+    {
+       public:
+        // Segments whose mode is Linear are slerped, all others (or all, without modes) use squad
+        void Build(const std::vector<Types::Keyframe>& keyframes,
+                   std::span<const Types::KeyframeInterpolationMode> segmentModes = {});
+        glm::vec3 Evaluate(float tick) const;
+        glm::vec3 EvaluateLinear(float tick) const;
+        // Like Evaluate, for a position t in [0, 1] within the segment after the given keyframe
+        glm::vec3 EvaluateSegment(std::size_t segment, float t) const;
+
+        bool IsEmpty() const
+        {
+            return ticks.empty();
+        }
+
+       private:
+        // Index of the segment containing the tick and the position within it, in [0, 1]
+        std::pair<std::size_t, float> FindSegment(float tick) const;
+
+        std::vector<float> ticks;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::quat> outgoingControlPoints;
+        std::vector<glm::quat> incomingControlPoints;
+    };
+}  // namespace IWXMVM::MathUtils
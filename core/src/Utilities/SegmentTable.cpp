@@ -0,0 +1,272 @@
+#include "StdInclude.hpp"
+#include "SegmentTable.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    namespace
+    {
+        bool IsAngle(Types::KeyframeValueType valueType, std::size_t valueIndex)
+        {
+            return valueType == Types::KeyframeValueType::CameraData && valueIndex >= 3 && valueIndex <= 5;
+        }
+
+        // Cubic through p0 and p1 with the given slopes, which are relative to the segment length
+        auto GetHermiteCoefficients(float p0, float p1, float m0, float m1)
+        {
+            return std::array<float, 4>{2.0f * p0 - 2.0f * p1 + m0 + m1, -3.0f * p0 + 3.0f * p1 - 2.0f * m0 - m1, m0,
+                                        p0};
+        }
+
+        // Copyright (c) by NUMERICAL RECIPES IN C: THE ART OF SCIENTIFIC COMPUTING (ISBN 0-521-43108-5)
+        // Modified. Thank you to dtugend for finding this!
+        // Second derivatives of the cubic spline through the given points, with zero slope at both ends
+        std::vector<float> ComputeSplineSecondDerivatives(std::span<const float> ticks, std::span<const float> values)
+        {
+            const size_t n = ticks.size();
+            assert(n >= 2);
+
+            std::vector<float> y2(n);  // second derivatives
+            std::vector<float> u(n);
+
+            y2[0] = -0.5f;
+            u[0] = (3.0f / (ticks[1] - ticks[0])) * ((values[1] - values[0]) / (ticks[1] - ticks[0]));
+
+            for (size_t i = 1; i <= n - 2; i++)
+            {
+                const auto prevTick = ticks[i - 1];
+                const auto prevValue = values[i - 1];
+                const auto currTick = ticks[i];
+                const auto currValue = values[i];
+                const auto nextTick = ticks[i + 1];
+                const auto nextValue = values[i + 1];
+
+                auto sig = (currTick - prevTick) / (nextTick - prevTick);
+                auto p = sig * y2[i - 1] + 2.0f;
+                y2[i] = (sig - 1.0f) / p;
+                u[i] = (nextValue - currValue) / (nextTick - currTick) - (currValue - prevValue) / (currTick - prevTick);
+                u[i] = (6.0f * u[i] / (nextTick - prevTick) - sig * u[i - 1]) / p;
+            }
+
+            auto qn = 0.5f;
+            auto un = (3.0f / (ticks[n - 1] - ticks[n - 2])) *
+                      (0.0f - (values[n - 1] - values[n - 2]) / (ticks[n - 1] - ticks[n - 2]));
+
+            y2[n - 1] = (un - qn * u[n - 2]) / (qn * y2[n - 2] + 1.0f);
+
+            for (int k = static_cast<int>(n) - 2; k >= 0; k--)
+                y2[k] = y2[k] * y2[k + 1] + u[k];
+
+            return y2;
+        }
+    }  // namespace
+
+    void SegmentTable::Compile(const Types::KeyframeableProperty& property,
+                               const std::vector<Types::Keyframe>& keyframes)
+    {
+        valueType = property.valueType;
+        valueCount = static_cast<std::size_t>(property.GetValueCount());
+
+        const auto n = keyframes.size();
+
+        ticks.resize(n);
+        for (std::size_t i = 0; i < n; i++)
+            ticks[i] = static_cast<float>(keyframes[i].tick);
+
+        const auto segmentCount = n > 1 ? n - 1 : 0;
+        inverseSegmentLengths.resize(segmentCount);
+        segmentUsesRotationSpline.resize(segmentCount);
+        coefficients.resize(segmentCount * valueCount);
+
+        if (n == 0)
+            return;
+
+        firstValue = keyframes.front().value;
+
+        // like before per-keyframe modes existed, tracks with less than 4 keyframes don't get cubic segments
+        const bool allowCubic = n >= 4;
+
+        std::vector<Types::KeyframeInterpolationMode> segmentModes(segmentCount);
+        for (std::size_t i = 0; i < segmentCount; i++)
+        {
+            segmentModes[i] = keyframes[i].interpolation.mode;
+            if (segmentModes[i] == Types::KeyframeInterpolationMode::Cubic && !allowCubic)
+                segmentModes[i] = Types::KeyframeInterpolationMode::Linear;
+
+            segmentUsesRotationSpline[i] = segmentModes[i] == Types::KeyframeInterpolationMode::Cubic ||
+                                           segmentModes[i] == Types::KeyframeInterpolationMode::Linear;
+        }
+
+        if (valueType == Types::KeyframeValueType::CameraData)
+            rotationSpline.Build(keyframes, segmentModes);
+
+        if (n == 1)
+            return;
+
+        // values per channel, with angles unwrapped so that every key is within 180 degrees of the previous one
+        std::vector<float> values(valueCount * n);
+        for (std::size_t j = 0; j < valueCount; j++)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                auto value = keyframes[i].value.GetByIndex(static_cast<uint32_t>(j));
+                if (i > 0 && IsAngle(valueType, j))
+                {
+                    const auto previous = values[j * n + i - 1];
+                    value += 360.0f * std::round((previous - value) / 360.0f);
+                }
+                values[j * n + i] = value;
+            }
+        }
+
+        std::vector<float> secondDerivatives;
+        if (allowCubic)
+        {
+            secondDerivatives.reserve(valueCount * n);
+            for (std::size_t j = 0; j < valueCount; j++)
+            {
+                const auto channel = ComputeSplineSecondDerivatives(ticks, std::span(values).subspan(j * n, n));
+                secondDerivatives.insert(secondDerivatives.end(), channel.begin(), channel.end());
+            }
+        }
+
+        auto GetSlope = [&](std::size_t j, std::size_t from, std::size_t to) {
+            const auto length = ticks[to] - ticks[from];
+            return length > 0.0f ? (values[j * n + to] - values[j * n + from]) / length : 0.0f;
+        };
+
+        // Kochanek-Bartels tangent of keyframe i, in units per tick
+        auto GetTCBTangent = [&](std::size_t j, std::size_t i, bool outgoing) {
+            const auto& parameters = keyframes[i].interpolation.GetParameters();
+            const auto t = parameters.tension;
+            const auto c = outgoing ? parameters.continuity : -parameters.continuity;
+            const auto b = parameters.bias;
+
+            const auto incomingSlope = i > 0 ? GetSlope(j, i - 1, i) : GetSlope(j, i, i + 1);
+            const auto outgoingSlope = i < n - 1 ? GetSlope(j, i, i + 1) : GetSlope(j, i - 1, i);
+
+            return (1.0f - t) * (1.0f + b) * (1.0f - c) * 0.5f * incomingSlope +
+                   (1.0f - t) * (1.0f - b) * (1.0f + c) * 0.5f * outgoingSlope;
+        };
+
+        for (std::size_t i = 0; i < segmentCount; i++)
+        {
+            const auto length = ticks[i + 1] - ticks[i];
+            inverseSegmentLengths[i] = length > 0.0f ? 1.0f / length : 0.0f;
+
+            const auto mode = segmentModes[i];
+
+            for (std::size_t j = 0; j < valueCount; j++)
+            {
+                const auto p0 = values[j * n + i];
+                const auto p1 = values[j * n + i + 1];
+
+                std::array<float, 4> c{};
+                switch (mode)
+                {
+                    case Types::KeyframeInterpolationMode::Hold:
+                        c = {0.0f, 0.0f, 0.0f, p0};
+                        break;
+                    case Types::KeyframeInterpolationMode::Linear:
+                        c = {0.0f, 0.0f, p1 - p0, p0};
+                        break;
+                    case Types::KeyframeInterpolationMode::Cubic:
+                    {
+                        const auto y0 = secondDerivatives[j * n + i];
+                        const auto y1 = secondDerivatives[j * n + i + 1];
+                        const auto k = length * length / 6.0f;
+                        c = {k * (y1 - y0), 3.0f * k * y0, p1 - p0 - k * (2.0f * y0 + y1), p0};
+                        break;
+                    }
+                    case Types::KeyframeInterpolationMode::Bezier:
+                    {
+                        const auto outTangent = keyframes[i].interpolation.GetParameters().outTangents[j];
+                        const auto inTangent = keyframes[i + 1].interpolation.GetParameters().inTangents[j];
+                        c = GetHermiteCoefficients(p0, p1, outTangent * length, inTangent * length);
+                        break;
+                    }
+                    case Types::KeyframeInterpolationMode::TCB:
+                        c = GetHermiteCoefficients(p0, p1, GetTCBTangent(j, i, true) * length,
+                                                   GetTCBTangent(j, i + 1, false) * length);
+                        break;
+                }
+
+                coefficients[i * valueCount + j] = {c[0], c[1], c[2], c[3]};
+            }
+        }
+    }
+
+    std::pair<std::size_t, float> SegmentTable::FindSegment(float tick) const
+    {
+        assert(ticks.size() > 1);
+
+        const auto next = std::upper_bound(ticks.begin() + 1, ticks.end() - 1, tick);
+        const auto i = static_cast<std::size_t>(std::distance(ticks.begin() + 1, next));
+        return {i, std::clamp((tick - ticks[i]) * inverseSegmentLengths[i], 0.0f, 1.0f)};
+    }
+
+    Types::KeyframeValue SegmentTable::Evaluate(float tick) const
+    {
+        assert(!ticks.empty());
+
+        if (ticks.size() == 1)
+            return firstValue;
+
+        const auto [i, s] = FindSegment(tick);
+
+        Types::KeyframeValue value;
+        const auto* segment = &coefficients[i * valueCount];
+        for (std::size_t j = 0; j < valueCount; j++)
+        {
+            const auto& c = segment[j];
+            value.SetByIndex(static_cast<uint32_t>(j), ((c.a * s + c.b) * s + c.c) * s + c.d);
+        }
+
+        if (valueType == Types::KeyframeValueType::CameraData)
+        {
+            // both rotations are evaluated, so that picking one doesn't depend on the mode of the segment
+            const std::array<glm::vec3, 2> rotations = {value.cameraData.rotation,
+                                                        rotationSpline.EvaluateSegment(i, s)};
+            value.cameraData.rotation = rotations[segmentUsesRotationSpline[i]];
+        }
+
+        return value;
+    }
+
+    glm::vec3 SegmentTable::EvaluateVector3(float tick) const
+    {
+        assert(!ticks.empty() && valueCount >= 3);
+
+        if (ticks.size() == 1)
+            return glm::vec3(firstValue.GetByIndex(0), firstValue.GetByIndex(1), firstValue.GetByIndex(2));
+
+        const auto [i, s] = FindSegment(tick);
+
+        glm::vec3 value;
+        const auto* segment = &coefficients[i * valueCount];
+        for (glm::length_t j = 0; j < 3; j++)
+        {
+            const auto& c = segment[j];
+            value[j] = ((c.a * s + c.b) * s + c.c) * s + c.d;
+        }
+        return value;
+    }
+
+    glm::vec3 SegmentTable::EvaluateVector3Derivative(float tick) const
+    {
+        assert(!ticks.empty() && valueCount >= 3);
+
+        if (ticks.size() == 1)
+            return glm::vec3(0.0f);
+
+        const auto [i, s] = FindSegment(tick);
+
+        glm::vec3 derivative;
+        const auto* segment = &coefficients[i * valueCount];
+        for (glm::length_t j = 0; j < 3; j++)
+        {
+            const auto& c = segment[j];
+            derivative[j] = ((3.0f * c.a * s + 2.0f * c.b) * s + c.c) * inverseSegmentLengths[i];
+        }
+        return derivative;
+    }
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,48 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "RotationSpline.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // A keyframe track compiled into one cubic polynomial per segment and value, so that evaluating it only takes a
+    // binary search for the segment and Horner's method, no matter which interpolation modes the keyframes use.
+    // Camera rotations in linear and cubic segments are taken from a quaternion spline instead, all other modes
+    // interpolate the unwrapped euler angles; both are evaluated and the segment selects one without branching.
+    // Compiling is linear in the number of keyframes, so owners are expected to only do it when the track changed
+    // (see KeyframeManager::GetKeyframesRevision).
+    class SegmentTable
+    {
+       public:
+        void Compile(const Types::KeyframeableProperty& property, const std::vector<Types::Keyframe>& keyframes);
+
+        Types::KeyframeValue Evaluate(float tick) const;
+        // Only the first three values (a vector or the camera position), e.g. for sampling the path of a camera
+        glm::vec3 EvaluateVector3(float tick) const;
+        // Derivative of EvaluateVector3 in units per tick, taken from the segment's polynomial
+        glm::vec3 EvaluateVector3Derivative(float tick) const;
+
+       private:
+        // v(s) = ((a * s + b) * s + c) * s + d, with s going from 0 to 1 over the segment
+        struct Coefficients
+        {
+            float a;
+            float b;
+            float c;
+            float d;
+        };
+
+        // Index of the segment containing the tick and the position within it, in [0, 1]
+        std::pair<std::size_t, float> FindSegment(float tick) const;
+
+        Types::KeyframeValueType valueType = Types::KeyframeValueType::FloatingPoint;
+        std::size_t valueCount = 0;
+
+        std::vector<float> ticks;
+        std::vector<float> inverseSegmentLengths;
+        std::vector<uint8_t> segmentUsesRotationSpline;  // cubic and linear camera rotations
+        std::vector<Coefficients> coefficients;  // valueCount entries per segment
+        Types::KeyframeValue firstValue;
+
+        RotationSpline rotationSpline;
+    };
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,319 @@
+#include "StdInclude.hpp"
+#include "Signatures.hpp"
+
+#include "PathUtils.hpp"
+#include "PatternScanner.hpp"
+#include "Profiler.hpp"
+
+namespace IWXMVM::Signatures
+{
+    namespace
+    {
+        constexpr std::array<char, 4> CACHE_MAGIC = {'I', 'W', 'X', 'S'};
+        constexpr uint32_t CACHE_VERSION = 1;
+
+        // A module is identified by the timestamp and image size from its PE header, and by a hash of its code, so
+        // that a patched executable with an unchanged header isn't mistaken for the cached one
+        struct ModuleIdentity
+        {
+            uint32_t timestamp;
+            uint32_t imageSize;
+            uint64_t codeHash;
+
+            bool operator==(const ModuleIdentity& other) const = default;
+        };
+
+        struct CacheHeader
+        {
+            std::array<char, 4> magic;
+            uint32_t version;
+            uint32_t moduleCount;
+            uint32_t entryCount;
+            // followed by the module identities and the entries
+        };
+
+        struct CacheEntry
+        {
+            uint64_t signatureHash;
+            uint32_t moduleIndex;
+            uint32_t matchOffset;  // relative to the module base
+        };
+
+        struct Module
+        {
+            HMODULE handle;
+            const std::uint8_t* begin;
+            const std::uint8_t* end;
+            ModuleIdentity identity;
+        };
+
+        std::vector<PendingSignature>& GetPendingSignatures()
+        {
+            static std::vector<PendingSignature> pendingSignatures;
+            return pendingSignatures;
+        }
+
+        uint64_t HashBytes(std::span<const std::uint8_t> bytes)
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ull;
+            for (const auto byte : bytes)
+            {
+                hash ^= byte;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::optional<Module> GetModule(HMODULE handle)
+        {
+            MODULEINFO process{};
+            if (!::GetModuleInformation(::GetCurrentProcess(), handle, &process, sizeof(process)) ||
+                !process.lpBaseOfDll)
+                return std::nullopt;
+
+            Module module{handle, reinterpret_cast<const std::uint8_t*>(process.lpBaseOfDll), nullptr, {}};
+            module.end = module.begin + process.SizeOfImage;
+
+            const auto* dosHeader = reinterpret_cast<const IMAGE_DOS_HEADER*>(module.begin);
+            const auto* ntHeaders = reinterpret_cast<const IMAGE_NT_HEADERS*>(module.begin + dosHeader->e_lfanew);
+            module.identity.timestamp = ntHeaders->FileHeader.TimeDateStamp;
+            module.identity.imageSize = process.SizeOfImage;
+
+            uint64_t codeHash = 0;
+            const auto* section = IMAGE_FIRST_SECTION(ntHeaders);
+            for (WORD i = 0; i < ntHeaders->FileHeader.NumberOfSections; i++, section++)
+            {
+                if ((section->Characteristics & IMAGE_SCN_CNT_CODE) == 0 ||
+                    section->VirtualAddress + section->Misc.VirtualSize > process.SizeOfImage)
+                    continue;
+
+                codeHash ^= HashBytes({module.begin + section->VirtualAddress, section->Misc.VirtualSize});
+            }
+            module.identity.codeHash = codeHash;
+
+            return module;
+        }
+
+        std::filesystem::path GetCachePath()
+        {
+            return PathUtils::GetIWXMVMPath() / "signatures.cache";
+        }
+
+        std::vector<std::pair<ModuleIdentity, CacheEntry>> ReadCache()
+        {
+            std::ifstream file(GetCachePath(), std::ios::binary);
+            if (!file.is_open())
+                return {};
+
+            CacheHeader header{};
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            if (!file || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION)
+                return {};
+
+            std::vector<ModuleIdentity> modules(header.moduleCount);
+            file.read(reinterpret_cast<char*>(modules.data()), modules.size() * sizeof(ModuleIdentity));
+
+            std::vector<CacheEntry> entries(header.entryCount);
+            file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(CacheEntry));
+            if (!file)
+                return {};
+
+            std::vector<std::pair<ModuleIdentity, CacheEntry>> result;
+            result.reserve(entries.size());
+            for (const auto& entry : entries)
+            {
+                if (entry.moduleIndex < modules.size())
+                    result.emplace_back(modules[entry.moduleIndex], entry);
+            }
+            return result;
+        }
+
+        void WriteCache(const std::vector<Module>& modules, const std::vector<CacheEntry>& entries)
+        {
+            std::error_code error;
+            std::filesystem::create_directories(GetCachePath().parent_path(), error);
+
+            std::ofstream file(GetCachePath(), std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                LOG_WARN("Failed to write signature cache to {}", GetCachePath().string());
+                return;
+            }
+
+            const CacheHeader header{CACHE_MAGIC, CACHE_VERSION, static_cast<uint32_t>(modules.size()),
+                                     static_cast<uint32_t>(entries.size())};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const auto& module : modules)
+                file.write(reinterpret_cast<const char*>(&module.identity), sizeof(ModuleIdentity));
+            file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(CacheEntry));
+        }
+
+        uint64_t GetSignatureHash(const PendingSignature& signature)
+        {
+            const std::string_view string = signature.string;
+            return HashBytes({reinterpret_cast<const std::uint8_t*>(string.data()), string.size()});
+        }
+
+        ScanPattern GetScanPattern(const PendingSignature& signature)
+        {
+            return {signature.bytes, signature.frontMaskCount};
+        }
+
+        // Scans for all given signatures at once, signatures that aren't found keep their match
+        void ScanModule(const Module& module, std::span<const std::size_t> signatureIndices,
+                        std::vector<std::uintptr_t>& matches)
+        {
+            const auto& pendingSignatures = GetPendingSignatures();
+
+            std::vector<ScanPattern> patterns;
+            patterns.reserve(signatureIndices.size());
+            for (const auto signatureIndex : signatureIndices)
+                patterns.push_back(GetScanPattern(pendingSignatures[signatureIndex]));
+
+            const auto moduleMatches =
+                ScanForPatterns({module.begin, static_cast<std::size_t>(module.end - module.begin)}, patterns);
+            for (std::size_t i = 0; i < signatureIndices.size(); i++)
+            {
+                if (moduleMatches[i] != nullptr)
+                    matches[signatureIndices[i]] = reinterpret_cast<std::uintptr_t>(moduleMatches[i]);
+            }
+        }
+    }  // namespace
+
+    void EnqueueSignature(const PendingSignature& signature)
+    {
+        GetPendingSignatures().push_back(signature);
+    }
+
+    void ResolvePendingSignatures()
+    {
+        PROFILE_FUNCTION();
+
+        auto& pendingSignatures = GetPendingSignatures();
+        std::vector<std::uintptr_t> matches(pendingSignatures.size(), 0);
+        std::vector<std::size_t> matchModules(pendingSignatures.size(), 0);
+
+        // modules are scanned in the order the signatures list them in, signatures that weren't found in one module
+        // are looked for in the next one
+        std::vector<Module> modules;
+        for (const auto& signature : pendingSignatures)
+        {
+            for (const auto handle : signature.modules)
+            {
+                if (std::find_if(modules.begin(), modules.end(), [&](const auto& m) { return m.handle == handle; }) !=
+                    modules.end())
+                    continue;
+
+                if (const auto module = GetModule(handle); module.has_value())
+                    modules.push_back(module.value());
+            }
+        }
+
+        auto FindModule = [&](HMODULE handle) {
+            return std::find_if(modules.begin(), modules.end(), [&](const auto& m) { return m.handle == handle; });
+        };
+
+        // cached matches are only used if their module is unchanged and the bytes at them still match
+        std::size_t cachedCount = 0;
+        const auto cache = ReadCache();
+        for (std::size_t i = 0; i < pendingSignatures.size(); i++)
+        {
+            const auto& signature = pendingSignatures[i];
+            const auto signatureHash = GetSignatureHash(signature);
+
+            for (const auto& [identity, entry] : cache)
+            {
+                if (matches[i] != 0)
+                    break;
+                if (entry.signatureHash != signatureHash)
+                    continue;
+
+                for (const auto handle : signature.modules)
+                {
+                    const auto module = FindModule(handle);
+                    if (module == modules.end() || module->identity != identity)
+                        continue;
+
+                    const auto* start = module->begin + entry.matchOffset;
+                    const auto moduleBytes =
+                        std::span(module->begin, static_cast<std::size_t>(module->end - module->begin));
+                    if (MatchesAt(GetScanPattern(signature), moduleBytes, start))
+                    {
+                        matches[i] = reinterpret_cast<std::uintptr_t>(start);
+                        matchModules[i] = static_cast<std::size_t>(std::distance(modules.begin(), module));
+                        cachedCount++;
+                    }
+                    break;
+                }
+            }
+        }
+
+        for (std::size_t moduleIndex = 0; moduleIndex < modules.size(); moduleIndex++)
+        {
+            std::vector<std::size_t> signatureIndices;
+            for (std::size_t i = 0; i < pendingSignatures.size(); i++)
+            {
+                const auto& signatureModules = pendingSignatures[i].modules;
+                if (matches[i] == 0 && std::find(signatureModules.begin(), signatureModules.end(),
+                                                 modules[moduleIndex].handle) != signatureModules.end())
+                    signatureIndices.push_back(i);
+            }
+
+            if (signatureIndices.empty())
+                continue;
+
+            ScanModule(modules[moduleIndex], signatureIndices, matches);
+            for (const auto i : signatureIndices)
+                matchModules[i] = moduleIndex;
+        }
+
+        if (cachedCount == pendingSignatures.size())
+        {
+            LOG_DEBUG("Resolved all {} signatures from the cache", cachedCount);
+        }
+        else
+        {
+            LOG_DEBUG("Resolved {} of {} signatures from the cache, scanned for the rest", cachedCount,
+                      pendingSignatures.size());
+
+            std::vector<CacheEntry> entries;
+            for (std::size_t i = 0; i < pendingSignatures.size(); i++)
+            {
+                if (matches[i] == 0)
+                    continue;
+
+                const auto& module = modules[matchModules[i]];
+                const auto matchOffset = reinterpret_cast<const std::uint8_t*>(matches[i]) - module.begin;
+                entries.push_back({GetSignatureHash(pendingSignatures[i]), static_cast<uint32_t>(matchModules[i]),
+                                   static_cast<uint32_t>(matchOffset)});
+            }
+            WriteCache(modules, entries);
+        }
+
+        // every signature is resolved before reporting, so that all missing ones are listed at once
+        std::string errors;
+        std::size_t errorCount = 0;
+        for (std::size_t i = 0; i < pendingSignatures.size(); i++)
+        {
+            const auto& signature = pendingSignatures[i];
+            try
+            {
+                if (matches[i] == 0)
+                    throw std::runtime_error(std::format("Failed to find signature:\n\t {}", signature.string));
+
+                *signature.address = signature.resolve(matches[i] + signature.offset);
+            }
+            catch (const std::exception& e)
+            {
+                errors += std::format("{}\n", e.what());
+                errorCount++;
+            }
+        }
+
+        pendingSignatures.clear();
+
+        if (errorCount > 0)
+            throw std::runtime_error(std::format("{} signatures could not be resolved:\n{}", errorCount, errors));
+    }
+}  // namespace IWXMVM::Signatures
@@ -1,6 +1,7 @@
 #pragma once
 #include "StdInclude.hpp"
 #include "Mod.hpp"
+#include "PatternScanner.hpp"
 
 namespace IWXMVM::Signatures
 {
@@ -35,8 +36,6 @@ namespace IWXMVM::Signatures
         };
     }  // namespace Lambdas
 
-    inline constexpr std::uint16_t maskValue = UINT8_MAX + 1;
-
     enum struct GameAddressType : std::uint8_t
     {
         Data = 4,
@@ -155,36 +154,21 @@ namespace IWXMVM::Signatures
         return bytes;
     }
 
-    inline std::uintptr_t SignatureScanner(const auto& signature, const auto& moduleHandles)
+    struct PendingSignature
     {
-        for (const auto handle : moduleHandles)
-        {
-            MODULEINFO process{};
-
-            if (!::GetModuleInformation(::GetCurrentProcess(), handle, &process, sizeof(process)) ||
-                !process.lpBaseOfDll)
-                return 0;
-
-            const std::uintptr_t endOfDll = reinterpret_cast<std::uintptr_t>(process.lpBaseOfDll) + process.SizeOfImage;
-
-            for (std::uintptr_t i = reinterpret_cast<std::uintptr_t>(process.lpBaseOfDll); i < endOfDll; ++i)
-            {
-                std::size_t j = signature._frontMaskCount;
-
-                for (; j < signature._bytes.size(); ++j)
-                {
-                    if (signature._bytes[j] != maskValue &&
-                        signature._bytes[j] != *reinterpret_cast<std::uint8_t*>(i + j))
-                        break;
-                }
-
-                if (j == signature._bytes.size())
-                    return i + signature._offset;
-            }
-        }
+        std::span<const std::uint16_t> bytes;
+        std::size_t frontMaskCount;
+        std::intptr_t offset;
+        const char* string;
+        std::span<HMODULE> modules;
+        std::uintptr_t (*resolve)(std::uintptr_t address);
+        std::uintptr_t* address;
+    };
 
-        return 0;
-    }
+    // Signatures are collected while the address struct is constructed and scanned for all at once afterwards, with a
+    // single pass over each module
+    void EnqueueSignature(const PendingSignature& signature);
+    void ResolvePendingSignatures();
 
     using callable_t = decltype([]() {});
 
@@ -204,36 +188,29 @@ namespace IWXMVM::Signatures
             static_assert(size > 0);
         }
 
-        auto Scan(const auto& moduleHandles) const
+        std::uintptr_t Resolve(std::uintptr_t address) const
         {
-            const std::uintptr_t address = SignatureScanner(*this, moduleHandles);
-
-            if (address == 0)
-                throw std::runtime_error(std::format("Failed to find signature:\n\t {}", _string.data()));
-            else
+            if constexpr (requires { std::declval<Callable>()(address); })
             {
-                if constexpr (requires { std::declval<Callable>()(address); })
+                try
                 {
-                    try
-                    {
-                        const std::uintptr_t newAddress = _callable(address);
-                        if (newAddress == 0)
-                            throw std::runtime_error(std::format(
-                                "Failed to find correct game address (1), signature:\n\t {}", _string.data()));
-
-                        return newAddress;
-                    }
-                    catch (...)
-                    {
-                        throw std::runtime_error(
-                            std::format("Failed to find correct game address (2), signature:\n\t {}", _string.data()));
-                    }
-
-                    return std::uintptr_t{};
+                    const std::uintptr_t newAddress = _callable(address);
+                    if (newAddress == 0)
+                        throw std::runtime_error(std::format(
+                            "Failed to find correct game address (1), signature:\n\t {}", _string.data()));
+
+                    return newAddress;
                 }
-                else
-                    return address;
+                catch (...)
+                {
+                    throw std::runtime_error(
+                        std::format("Failed to find correct game address (2), signature:\n\t {}", _string.data()));
+                }
+
+                return std::uintptr_t{};
             }
+            else
+                return address;
         }
 
         std::array<char, size> _string{};
@@ -249,7 +226,11 @@ namespace IWXMVM::Signatures
         constexpr Signature()
         {
             if (const auto modules = Mod::GetGameInterface()->GetModuleHandles(type); modules.has_value())
-                _address = _signature.Scan(modules.value());
+            {
+                EnqueueSignature({_signature._bytes, _signature._frontMaskCount, _signature._offset,
+                                  _signature._string.data(), modules.value(),
+                                  [](std::uintptr_t address) { return _signature.Resolve(address); }, &_address});
+            }
         }
 
         static constexpr auto _signature = intSignature;
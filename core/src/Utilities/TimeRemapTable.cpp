@@ -0,0 +1,163 @@
+#include "StdInclude.hpp"
+#include "TimeRemapTable.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    namespace
+    {
+        // 5-point Gauss-Legendre abscissae and weights on [-1, 1]
+        constexpr std::array<double, 5> GAUSS_NODES = {0.0, -0.5384693101056831, 0.5384693101056831,
+                                                       -0.9061798459386640, 0.9061798459386640};
+        constexpr std::array<double, 5> GAUSS_WEIGHTS = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665,
+                                                         0.2369268850561891, 0.2369268850561891};
+
+        double ClampSpeed(double speed)
+        {
+            return std::max(speed, TimeRemapTable::MIN_SPEED);
+        }
+
+        // output time it takes to play from a to b, at a speed that changes linearly from speedA to speedB
+        double IntegrateLinear(double a, double b, double speedA, double speedB)
+        {
+            const auto slope = (speedB - speedA) / (b - a);
+            if (std::abs(speedB - speedA) < 1e-9 * speedA)
+                return (b - a) / speedA;
+            return std::log(speedB / speedA) / slope;
+        }
+
+        double IntegrateGaussLegendre(const TimeRemapTable::SpeedFunction& speed, double a, double b)
+        {
+            const auto halfLength = 0.5 * (b - a);
+            const auto center = 0.5 * (a + b);
+
+            double sum = 0.0;
+            for (std::size_t i = 0; i < GAUSS_NODES.size(); i++)
+            {
+                const auto tick = static_cast<float>(center + halfLength * GAUSS_NODES[i]);
+                sum += GAUSS_WEIGHTS[i] / ClampSpeed(speed(tick));
+            }
+            return sum * halfLength;
+        }
+    }  // namespace
+
+    void TimeRemapTable::Update(const std::vector<Types::Keyframe>& keyframes, const SpeedFunction& speed)
+    {
+        std::vector<Node> newNodes;
+        newNodes.reserve(keyframes.size());
+        for (const auto& keyframe : keyframes)
+            newNodes.push_back({keyframe.tick, keyframe.value.floatingPoint, keyframe.interpolation});
+
+        // speed tracks only have a handful of keyframes, so the table is simply rebuilt whenever one changes
+        if (newNodes == nodes)
+            return;
+
+        nodes = std::move(newNodes);
+        segments.clear();
+
+        const auto n = nodes.size();
+        for (std::size_t i = 0; i + 1 < n; i++)
+        {
+            Segment segment{static_cast<double>(nodes[i].tick), static_cast<double>(nodes[i + 1].tick), {}};
+
+            // like in the segment table, tracks with less than 4 keyframes don't get cubic segments
+            auto mode = nodes[i].interpolation.mode;
+            if (mode == Types::KeyframeInterpolationMode::Cubic && n < 4)
+                mode = Types::KeyframeInterpolationMode::Linear;
+
+            const auto speedA = ClampSpeed(nodes[i].speed);
+            const auto speedB = ClampSpeed(nodes[i + 1].speed);
+            const auto length = segment.endTick - segment.startTick;
+            const auto step = length / SAMPLES_PER_SEGMENT;
+            if (length <= 0.0)
+            {
+                segments.push_back(segment);
+                continue;
+            }
+
+            double time = 0.0;
+            for (std::size_t j = 0; j < SAMPLES_PER_SEGMENT; j++)
+            {
+                const auto a = segment.startTick + step * static_cast<double>(j);
+                const auto b = a + step;
+
+                if (mode == Types::KeyframeInterpolationMode::Hold)
+                {
+                    time += step / speedA;
+                }
+                else if (mode == Types::KeyframeInterpolationMode::Linear)
+                {
+                    const auto speedAtA = speedA + (speedB - speedA) * (a - segment.startTick) / length;
+                    const auto speedAtB = speedA + (speedB - speedA) * (b - segment.startTick) / length;
+                    time += IntegrateLinear(a, b, speedAtA, speedAtB);
+                }
+                else
+                {
+                    time += IntegrateGaussLegendre(speed, a, b);
+                }
+
+                segment.times[j + 1] = time;
+            }
+
+            segments.push_back(segment);
+        }
+
+        segmentStartTimes.resize(segments.size() + 1);
+        segmentStartTimes[0] = 0.0;
+        for (std::size_t i = 0; i < segments.size(); i++)
+            segmentStartTimes[i + 1] = segmentStartTimes[i] + segments[i].times.back();
+    }
+
+    double TimeRemapTable::GetOutputTime(double tick) const
+    {
+        assert(!nodes.empty());
+
+        // constant speed outside of the keyframes, with the output time relative to the first keyframe
+        const auto firstTick = static_cast<double>(nodes.front().tick);
+        const auto lastTick = static_cast<double>(nodes.back().tick);
+        if (tick <= firstTick || segments.empty())
+            return (tick - firstTick) / ClampSpeed(nodes.front().speed);
+        if (tick >= lastTick)
+            return segmentStartTimes.back() + (tick - lastTick) / ClampSpeed(nodes.back().speed);
+
+        const auto nextSegment = std::upper_bound(segments.begin() + 1, segments.end(), tick,
+                                                  [](double t, const Segment& s) { return t < s.startTick; });
+        const auto segmentIndex = static_cast<std::size_t>(std::distance(segments.begin(), nextSegment) - 1);
+        const auto& segment = segments[segmentIndex];
+
+        const auto step = (segment.endTick - segment.startTick) / SAMPLES_PER_SEGMENT;
+        const auto position = step > 0.0 ? (tick - segment.startTick) / step : 0.0;
+        const auto sample = std::min(static_cast<std::size_t>(position), SAMPLES_PER_SEGMENT - 1);
+        const auto t = position - static_cast<double>(sample);
+
+        return segmentStartTimes[segmentIndex] + segment.times[sample] +
+               (segment.times[sample + 1] - segment.times[sample]) * t;
+    }
+
+    double TimeRemapTable::GetTickAtOutputTime(double outputTime) const
+    {
+        assert(!nodes.empty());
+
+        const auto firstTick = static_cast<double>(nodes.front().tick);
+        const auto lastTick = static_cast<double>(nodes.back().tick);
+        if (outputTime <= 0.0 || segments.empty())
+            return firstTick + outputTime * ClampSpeed(nodes.front().speed);
+        if (outputTime >= segmentStartTimes.back())
+            return lastTick + (outputTime - segmentStartTimes.back()) * ClampSpeed(nodes.back().speed);
+
+        const auto nextSegment =
+            std::upper_bound(segmentStartTimes.begin() + 1, segmentStartTimes.end() - 1, outputTime);
+        const auto segmentIndex = static_cast<std::size_t>(std::distance(segmentStartTimes.begin() + 1, nextSegment));
+        const auto& segment = segments[segmentIndex];
+        const auto localTime = outputTime - segmentStartTimes[segmentIndex];
+
+        const auto nextSample = std::upper_bound(segment.times.begin() + 1, segment.times.end() - 1, localTime);
+        const auto sample = static_cast<std::size_t>(std::distance(segment.times.begin(), nextSample) - 1);
+
+        // the inverse of the linear interpolation in GetOutputTime, so that both stay consistent
+        const auto sampleTime = segment.times[sample + 1] - segment.times[sample];
+        const auto t = sampleTime > 0.0 ? (localTime - segment.times[sample]) / sampleTime : 0.0;
+
+        const auto step = (segment.endTick - segment.startTick) / SAMPLES_PER_SEGMENT;
+        return segment.startTick + step * (static_cast<double>(sample) + t);
+    }
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,46 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Maps demo ticks to output time for a playback speed track, where the speed is the number of demo ticks that are
+    // played per millisecond of output. Every segment between two keyframes stores the cumulative output time at a
+    // fixed number of sub-ticks: constant and linear segments are integrated analytically, curved ones with
+    // Gauss-Legendre quadrature. Before the first and after the last keyframe the speed stays constant.
+    class TimeRemapTable
+    {
+       public:
+        using SpeedFunction = std::function<float(float tick)>;
+
+        // speeds are clamped to MIN_SPEED, so a track that stops the demo still maps to a finite output time
+        static constexpr double MIN_SPEED = 0.001;
+
+        void Update(const std::vector<Types::Keyframe>& keyframes, const SpeedFunction& speed);
+
+        double GetOutputTime(double tick) const;
+        double GetTickAtOutputTime(double outputTime) const;
+
+       private:
+        static constexpr std::size_t SAMPLES_PER_SEGMENT = 16;
+
+        struct Node
+        {
+            uint32_t tick;
+            float speed;
+            Types::KeyframeInterpolation interpolation;
+
+            bool operator==(const Node& other) const = default;
+        };
+
+        struct Segment
+        {
+            double startTick;
+            double endTick;
+            std::array<double, SAMPLES_PER_SEGMENT + 1> times;  // cumulative, relative to the segment start
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Segment> segments;
+        std::vector<double> segmentStartTimes;
+    };
+}  // namespace IWXMVM::MathUtils
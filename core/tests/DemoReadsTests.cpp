@@ -0,0 +1,280 @@
+#include "StdInclude.hpp"
+
+#include "Utilities/DemoReads.hpp"
+
+#include <cstdio>
+#include <random>
+
+// Checks of the demo read trace replayer against traces of a simulated playback session, run by CTest. Every failed
+// check is printed, and the process exits with 1 if there was any.
+
+namespace IWXMVM::Tests
+{
+    int failureCount = 0;
+
+    void Check(bool condition, const char* description)
+    {
+        if (condition)
+            return;
+
+        std::fprintf(stderr, "FAILED: %s\n", description);
+        failureCount++;
+    }
+
+    // Like a demo: a gamestate, followed by messages that each consist of a one byte type, an 8 byte header and a body
+    struct Demo
+    {
+        std::filesystem::path path;
+        std::vector<uint32_t> bodyLengths;
+        uint32_t size = 0;
+    };
+
+    constexpr uint32_t GAMESTATE_LENGTH = 12'000;
+    constexpr uint32_t FOOTER_LENGTH = 9;
+
+    Demo WriteDemo(const std::filesystem::path& path, std::size_t messageCount, std::mt19937& random)
+    {
+        std::uniform_int_distribution<uint32_t> bodyLength(20, 400);
+
+        Demo demo{path, {}, 1 + 8 + GAMESTATE_LENGTH + FOOTER_LENGTH};
+        for (std::size_t i = 0; i < messageCount; i++)
+        {
+            demo.bodyLengths.push_back(bodyLength(random));
+            demo.size += 1 + 8 + demo.bodyLengths.back();
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        const std::vector<char> bytes(demo.size, 'x');
+        file.write(bytes.data(), bytes.size());
+        return demo;
+    }
+
+    // Makes reads the way Rewinding::FS_Read does for the game, and records them
+    class Session
+    {
+       public:
+        explicit Session(const Demo& demo, bool isRecording = true)
+            : recorder(demo.path.string()), demo(demo), isRecording(isRecording)
+        {
+            state.size = demo.size;
+        }
+
+        void ReadGamestate()
+        {
+            Read(1, false);
+            Read(8, false);
+            Read(GAMESTATE_LENGTH, false);
+        }
+
+        // rewinding restarts the file before the message type is read, at the message after the gamestate
+        void ReadMessage(std::size_t index, bool rewind = false)
+        {
+            Read(1, rewind);
+            Read(8, false);
+            Read(demo.bodyLengths[index], false);
+            serverTime += 50;
+        }
+
+        // only records the reads from now on
+        void StartRecording()
+        {
+            isRecording = true;
+        }
+
+        std::filesystem::path WriteTrace(const std::filesystem::path& path) const
+        {
+            recorder.WriteFile(path);
+            return path;
+        }
+
+        DemoReads::DemoFileState state;
+        DemoReads::TraceRecorder recorder;
+        int32_t serverTime = 1000;
+        uint32_t filePositionError = 0;  // moves the actual file position away from the tracked offset
+        uint64_t byteCount = 0;
+        std::size_t readCount = 0;
+
+       private:
+        void Read(uint32_t length, bool rewind)
+        {
+            DemoReads::BeginRead(state, static_cast<int>(length));
+            if (rewind && DemoReads::RestartFile(state))
+                serverTime = 1000;
+
+            if (isRecording)
+            {
+                recorder.Record(state.offset, state.offset + filePositionError, length, serverTime);
+                byteCount += length;
+                readCount++;
+            }
+            DemoReads::FinishRead(state, static_cast<int>(length));
+        }
+
+        const Demo& demo;
+        bool isRecording;
+    };
+
+    std::optional<DemoReads::ReplayResult> Replay(const std::filesystem::path& tracePath)
+    {
+        std::string error;
+        auto result = DemoReads::Replay(tracePath, {}, error);
+        if (!result.has_value())
+            std::fprintf(stderr, "%s\n", error.c_str());
+        return result;
+    }
+
+    bool HasViolation(const DemoReads::ReplayResult& result, std::string_view description)
+    {
+        return std::ranges::any_of(result.violations, [&](const auto& v) { return v.find(description) != v.npos; });
+    }
+
+    void TestRewindingSession(const Demo& demo, const std::filesystem::path& directory)
+    {
+        Session session(demo);
+        session.ReadGamestate();
+        for (std::size_t i = 0; i < 40; i++)
+            session.ReadMessage(i);
+        for (std::size_t i = 0; i < 60; i++)
+            session.ReadMessage(i, i == 0);
+
+        const auto result = Replay(session.WriteTrace(directory / "rewinding.trace"));
+        Check(result.has_value(), "trace of a rewinding session can be replayed");
+        if (!result.has_value())
+            return;
+
+        Check(result->readCount == session.readCount, "every recorded read is replayed");
+        Check(result->byteCount == session.byteCount, "every recorded byte is read");
+        Check(result->seekCount == 1, "the rewind is the only seek");
+        Check(result->violationCount == 0, "a rewinding session breaks no invariants");
+        for (const auto& violation : result->violations)
+            std::fprintf(stderr, "\t%s\n", violation.c_str());
+    }
+
+    void TestRecordingStartedLate(const Demo& demo, const std::filesystem::path& directory)
+    {
+        Session session(demo, false);
+        session.ReadGamestate();
+        for (std::size_t i = 0; i < 20; i++)
+            session.ReadMessage(i);
+
+        session.StartRecording();
+        for (std::size_t i = 20; i < 50; i++)
+            session.ReadMessage(i);
+        session.ReadMessage(0, true);
+
+        const auto result = Replay(session.WriteTrace(directory / "late.trace"));
+        Check(result.has_value() && result->violationCount == 0,
+              "a recording that starts in the middle of the demo breaks no invariants");
+        Check(result.has_value() && result->readCount == session.readCount,
+              "every read of a recording that starts in the middle of the demo is replayed");
+    }
+
+    void TestViolations(const Demo& demo, const std::filesystem::path& directory)
+    {
+        {
+            Session session(demo);
+            session.ReadGamestate();
+            for (std::size_t i = 0; i < 10; i++)
+                session.ReadMessage(i);
+            session.state.offset += 5;  // skips into the next message
+            session.ReadMessage(10);
+
+            const auto result = Replay(session.WriteTrace(directory / "seek.trace"));
+            Check(result.has_value() && HasViolation(*result, "seeked somewhere other than"),
+                  "seeking into a message is reported");
+        }
+        {
+            Session session(demo);
+            session.ReadGamestate();
+            for (std::size_t i = 0; i < 10; i++)
+                session.ReadMessage(i);
+            session.serverTime -= 500;
+            session.ReadMessage(10);
+
+            const auto result = Replay(session.WriteTrace(directory / "time.trace"));
+            Check(result.has_value() && HasViolation(*result, "went back in time"),
+                  "going back in time without seeking is reported");
+        }
+        {
+            Session session(demo);
+            session.ReadGamestate();
+            session.ReadMessage(0);
+            session.filePositionError = 3;
+            session.ReadMessage(1);
+
+            const auto result = Replay(session.WriteTrace(directory / "sync.trace"));
+            Check(result.has_value() && result->violationCount == 3 &&
+                      HasViolation(*result, "out of sync with the tracked offset"),
+                  "every read made while the file was out of sync is reported");
+        }
+        {
+            Session session(demo);
+            session.ReadGamestate();
+            for (std::size_t i = 0; i < demo.bodyLengths.size(); i++)
+                session.ReadMessage(i);
+            session.ReadMessage(0);  // past the footer
+
+            const auto result = Replay(session.WriteTrace(directory / "end.trace"));
+            Check(result.has_value() && HasViolation(*result, "past the end of the demo"),
+                  "reading past the end of the demo is reported");
+        }
+    }
+
+    void TestInvalidTraces(const Demo& demo, const std::filesystem::path& directory)
+    {
+        Session session(demo);
+        session.ReadGamestate();
+        for (std::size_t i = 0; i < 10; i++)
+            session.ReadMessage(i);
+        const auto tracePath = session.WriteTrace(directory / "truncated.trace");
+
+        std::string error;
+        std::filesystem::resize_file(tracePath, std::filesystem::file_size(tracePath) - 3);
+        Check(!DemoReads::Replay(tracePath, {}, error).has_value() && !error.empty(),
+              "a truncated trace is rejected");
+
+        error.clear();
+        std::filesystem::resize_file(tracePath, 6);
+        Check(!DemoReads::Replay(tracePath, {}, error).has_value() && !error.empty(),
+              "a trace without a whole header is rejected");
+
+        error.clear();
+        Check(!DemoReads::Replay(directory / "missing.trace", {}, error).has_value() && !error.empty(),
+              "a missing trace is rejected");
+
+        // the demo doesn't have to be where it was recorded
+        session.WriteTrace(directory / "moved.trace");
+        std::filesystem::rename(demo.path, directory / "moved.dm_1");
+        error.clear();
+        Check(!DemoReads::Replay(directory / "moved.trace", {}, error).has_value(),
+              "a trace of a demo that was moved can't be replayed without giving its new path");
+        Check(DemoReads::Replay(directory / "moved.trace", directory / "moved.dm_1", error).has_value(),
+              "a trace can be replayed on a demo that was moved");
+        std::filesystem::rename(directory / "moved.dm_1", demo.path);
+    }
+}  // namespace IWXMVM::Tests
+
+int main()
+{
+    using namespace IWXMVM::Tests;
+
+    const auto directory = std::filesystem::temp_directory_path() / "iwxmvm-demo-reads-tests";
+    std::filesystem::create_directories(directory);
+
+    std::mt19937 random(1);
+    const auto demo = WriteDemo(directory / "test.dm_1", 200, random);
+
+    TestRewindingSession(demo, directory);
+    TestRecordingStartedLate(demo, directory);
+    TestViolations(demo, directory);
+    TestInvalidTraces(demo, directory);
+
+    std::filesystem::remove_all(directory);
+
+    if (failureCount > 0)
+    {
+        std::fprintf(stderr, "%d checks failed\n", failureCount);
+        return 1;
+    }
+    return 0;
+}
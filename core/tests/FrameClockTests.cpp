@@ -0,0 +1,86 @@
+#include "StdInclude.hpp"
+
+#include "Utilities/FrameClock.hpp"
+
+#include <cstdio>
+
+// Checks of the frame stepping that CaptureManager records with, run by CTest. Every failed check is printed, and the
+// process exits with 1 if there was any.
+
+namespace IWXMVM::Tests
+{
+    int failureCount = 0;
+
+    void Check(bool condition, const char* description, int32_t numerator, int32_t denominator)
+    {
+        if (condition)
+            return;
+
+        std::fprintf(stderr, "FAILED: %s (%d / %d fps)\n", description, numerator, denominator);
+        failureCount++;
+    }
+
+    // After every frame the clock must be within one tick of the exact frame time, and after a whole number of
+    // seconds exactly on it
+    void TestFramerate(int32_t numerator, int32_t denominator)
+    {
+        MathUtils::FrameClock clock(numerator, denominator);
+
+        int64_t ticks = 0;
+        bool isWithinATick = true;
+        bool hasValidLengths = true;
+        for (int64_t frame = 1; frame <= 10 * numerator; frame++)
+        {
+            const auto delta = clock.Advance();
+            hasValidLengths = hasValidLengths && delta >= 1000 * denominator / numerator &&
+                              delta <= 1000 * denominator / numerator + 1;
+
+            ticks += delta;
+            const auto exactTicks = static_cast<double>(frame) * 1000.0 * denominator / numerator;
+            isWithinATick = isWithinATick && std::abs(static_cast<double>(ticks) - exactTicks) < 1.0;
+
+            const auto expectedFraction = exactTicks - std::floor(exactTicks + 1e-9);
+            isWithinATick = isWithinATick && std::abs(clock.GetTickFraction() - expectedFraction) < 1e-6;
+        }
+
+        Check(hasValidLengths, "frames are the rounded down or rounded up frame length", numerator, denominator);
+        Check(isWithinATick, "every frame is within a tick of the exact frame time", numerator, denominator);
+        Check(ticks == 10'000 * static_cast<int64_t>(denominator), "a whole number of seconds has no drift", numerator,
+              denominator);
+    }
+
+    void TestReset()
+    {
+        MathUtils::FrameClock clock(7);
+        for (int i = 0; i < 3; i++)
+            clock.Advance();
+
+        clock.Reset(30000, 1001);
+        MathUtils::FrameClock freshClock(30000, 1001);
+        bool isSame = true;
+        for (int i = 0; i < 1000; i++)
+            isSame = isSame && clock.Advance() == freshClock.Advance();
+
+        Check(isSame, "a reset clock steps like a new one", 30000, 1001);
+    }
+}  // namespace IWXMVM::Tests
+
+int main()
+{
+    using namespace IWXMVM::Tests;
+
+    for (const auto& [numerator, denominator] : std::initializer_list<std::pair<int32_t, int32_t>>{
+             {24, 1}, {25, 1}, {30, 1}, {60, 1}, {144, 1}, {250, 1}, {1000, 1}, {24000, 1001}, {30000, 1001},
+             {60000, 1001}})
+    {
+        TestFramerate(numerator, denominator);
+    }
+    TestReset();
+
+    if (failureCount > 0)
+    {
+        std::fprintf(stderr, "%d checks failed\n", failureCount);
+        return 1;
+    }
+    return 0;
+}
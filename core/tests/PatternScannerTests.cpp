@@ -0,0 +1,216 @@
+#include "StdInclude.hpp"
+
+#include "Utilities/PatternScanner.hpp"
+
+#include <cstdio>
+#include <random>
+
+// Checks of ScanForPatterns against a byte by byte search, run by CTest. Every failed check is printed, and the
+// process exits with 1 if there was any.
+
+namespace IWXMVM::Tests
+{
+    int failureCount = 0;
+
+    // Identified by the index of the pattern, or the position of the match for single patterns
+    void Check(bool condition, const char* description, std::size_t index)
+    {
+        if (condition)
+            return;
+
+        std::fprintf(stderr, "FAILED: %s (%zu)\n", description, index);
+        failureCount++;
+    }
+
+    // the scanner splits images into ranges of this size
+    constexpr std::size_t RANGE_SIZE = 1024 * 1024;
+
+    // Machine code like bytes: mostly zeroes, register encodings and int3 padding
+    std::vector<std::uint8_t> MakeImage(std::size_t size, std::mt19937& random)
+    {
+        std::discrete_distribution<int> byteClass({30, 5, 5, 3, 57});
+        std::uniform_int_distribution<int> anyByte(0, 255);
+        std::vector<std::uint8_t> image(size);
+        for (auto& byte : image)
+        {
+            constexpr std::array<std::uint8_t, 4> COMMON_BYTES = {0x00, 0xFF, 0x8B, 0xCC};
+            const auto c = byteClass(random);
+            byte = c < 4 ? COMMON_BYTES[c] : static_cast<std::uint8_t>(anyByte(random));
+        }
+        return image;
+    }
+
+    struct TestPattern
+    {
+        std::vector<std::uint16_t> bytes;
+        std::size_t frontMaskCount = 0;
+    };
+
+    // Writes random bytes into the image and returns them as a signature, with every fourth byte masked
+    TestPattern PlantPattern(std::vector<std::uint8_t>& image, std::size_t start, std::size_t length,
+                             std::size_t frontMaskCount, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> anyByte(0, 255);
+
+        TestPattern pattern{{}, frontMaskCount};
+        for (std::size_t i = 0; i < length; i++)
+        {
+            image[start + i] = static_cast<std::uint8_t>(anyByte(random));
+            const bool isMasked = i < frontMaskCount || i % 4 == 3;
+            pattern.bytes.push_back(isMasked ? Signatures::maskValue : image[start + i]);
+        }
+        return pattern;
+    }
+
+    const std::uint8_t* FindFirstMatch(const Signatures::ScanPattern& pattern, std::span<const std::uint8_t> image)
+    {
+        for (std::size_t i = 0; i + pattern.bytes.size() <= image.size(); i++)
+        {
+            if (Signatures::MatchesAt(pattern, image, image.data() + i))
+                return image.data() + i;
+        }
+        return nullptr;
+    }
+
+    std::vector<const std::uint8_t*> Scan(std::span<const std::uint8_t> image,
+                                          const std::vector<TestPattern>& testPatterns)
+    {
+        std::vector<Signatures::ScanPattern> patterns;
+        for (const auto& pattern : testPatterns)
+            patterns.push_back({pattern.bytes, pattern.frontMaskCount});
+        return Signatures::ScanForPatterns(image, patterns);
+    }
+
+    void CheckMatches(std::span<const std::uint8_t> image, const std::vector<TestPattern>& testPatterns,
+                      const char* description)
+    {
+        const auto matches = Scan(image, testPatterns);
+        Check(matches.size() == testPatterns.size(), "one result per pattern", testPatterns.size());
+
+        for (std::size_t i = 0; i < testPatterns.size() && i < matches.size(); i++)
+        {
+            const Signatures::ScanPattern pattern{testPatterns[i].bytes, testPatterns[i].frontMaskCount};
+            Check(matches[i] == FindFirstMatch(pattern, image), description, i);
+        }
+    }
+
+    void TestRangeBoundaries()
+    {
+        std::mt19937 random(1);
+
+        // not a multiple of the range size, so the last range is shorter than the others
+        auto image = MakeImage(3 * RANGE_SIZE + 1234, random);
+
+        for (std::size_t boundary = RANGE_SIZE; boundary < image.size(); boundary += RANGE_SIZE)
+        {
+            // start, length and masked bytes in front; matches can only be planted one at a time, since they overlap
+            std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> placements;
+            for (std::size_t offset = 1; offset < 24; offset += 2)
+                placements.push_back({boundary - offset, 24, 0});
+            placements.push_back({boundary - 20, 48, 0});  // too long to be compared as vectors
+            placements.push_back({boundary - 1, 12, 3});
+            placements.push_back({boundary - 3, 12, 3});  // only masked bytes before the boundary
+            placements.push_back({boundary, 12, 0});
+
+            for (const auto& [start, length, frontMaskCount] : placements)
+            {
+                const auto pattern = PlantPattern(image, start, length, frontMaskCount, random);
+                const auto matches = Scan(image, {pattern});
+                Check(matches.front() == image.data() + start, "match across a range boundary", start);
+                Check(matches.front() == FindFirstMatch({pattern.bytes, frontMaskCount}, image),
+                      "same first match across a range boundary as a byte by byte search", start);
+            }
+        }
+    }
+
+    void TestImageEnds()
+    {
+        std::mt19937 random(2);
+        auto image = MakeImage(2 * RANGE_SIZE + 77, random);
+
+        std::vector<TestPattern> patterns;
+        patterns.push_back(PlantPattern(image, 0, 20, 0, random));
+        patterns.push_back(PlantPattern(image, 32, 24, 5, random));
+        patterns.push_back(PlantPattern(image, image.size() - 16, 16, 0, random));
+        patterns.push_back(PlantPattern(image, image.size() - 80, 40, 2, random));
+        patterns.push_back(PlantPattern(image, image.size() - 30, 12, 0, random));
+
+        const auto matches = Scan(image, patterns);
+        Check(matches[0] == image.data(), "match at the start of the image", 0);
+        Check(matches[1] == image.data() + 32, "match with masked bytes at the start of the image", 1);
+        Check(matches[2] == image.data() + image.size() - 16, "match at the end of the image", 2);
+        Check(matches[3] == image.data() + image.size() - 80, "long match near the end of the image", 3);
+        Check(matches[4] == image.data() + image.size() - 30, "match in the last vector of the image", 4);
+
+        CheckMatches(image, patterns, "same first match at the ends of the image as a byte by byte search");
+    }
+
+    void TestMatchesBruteForce()
+    {
+        std::mt19937 random(3);
+        auto image = MakeImage(3 * RANGE_SIZE + 1234, random);
+
+        std::vector<TestPattern> patterns;
+
+        // taken from the image as it is, which are often found much earlier than where they were taken from
+        std::uniform_int_distribution<std::size_t> position(0, image.size() - 32);
+        for (std::size_t i = 0; i < 48; i++)
+        {
+            const auto start = position(random);
+            TestPattern pattern{{image.begin() + start, image.begin() + start + 8 + i % 24}, 0};
+            for (std::size_t j = 2; j < pattern.bytes.size(); j += 5)
+                pattern.bytes[j] = Signatures::maskValue;
+            patterns.push_back(std::move(pattern));
+        }
+
+        // only the earlier of two matches in different ranges counts
+        patterns.push_back(PlantPattern(image, 2 * RANGE_SIZE + 5000, 16, 0, random));
+        std::copy_n(image.begin() + 2 * RANGE_SIZE + 5000, 16, image.begin() + RANGE_SIZE + 7000);
+
+        // a pattern that doesn't occur anywhere
+        patterns.push_back({std::vector<std::uint16_t>(24, 0x5A), 0});
+        patterns.back().bytes[10] = 0xA5;
+
+        CheckMatches(image, patterns, "same first match as a byte by byte search");
+
+        const auto matches = Scan(image, patterns);
+        Check(matches[48] == image.data() + RANGE_SIZE + 7000, "earliest of two matches", 48);
+        Check(matches[49] == nullptr, "missing pattern isn't found", 49);
+    }
+
+    void TestSmallImages()
+    {
+        std::mt19937 random(4);
+
+        // images shorter than a vector, and patterns as long as the whole image or longer
+        for (std::size_t size = 4; size < 40; size++)
+        {
+            auto image = MakeImage(size, random);
+
+            std::vector<TestPattern> patterns;
+            patterns.push_back(PlantPattern(image, 0, size, 0, random));
+            patterns.push_back({{image.end() - 4, image.end()}, 0});
+            patterns.push_back(patterns.front());
+            patterns.back().bytes.push_back(0x90);
+
+            CheckMatches(image, patterns, "same first match in a small image as a byte by byte search");
+        }
+    }
+}  // namespace IWXMVM::Tests
+
+int main()
+{
+    using namespace IWXMVM::Tests;
+
+    TestRangeBoundaries();
+    TestImageEnds();
+    TestMatchesBruteForce();
+    TestSmallImages();
+
+    if (failureCount > 0)
+    {
+        std::fprintf(stderr, "%d checks failed\n", failureCount);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "StdInclude.hpp"
+
+#include "Utilities/RotationSpline.hpp"
+
+#include <cstdio>
+
+// Checks of RotationSpline, run by CTest. Every failed check is printed, and the process exits with 1 if there was any.
+
+namespace IWXMVM::Tests
+{
+    int failureCount = 0;
+
+    void Check(bool condition, const char* description, float tick)
+    {
+        if (condition)
+            return;
+
+        std::fprintf(stderr, "FAILED: %s (tick %.2f)\n", description, tick);
+        failureCount++;
+    }
+
+    const Types::KeyframeableProperty cameraProperty(Types::KeyframeablePropertyType::CampathCamera, "Camera",
+                                                     Types::KeyframeValueType::CameraData, -10000.0f, 10000.0f);
+
+    std::vector<Types::Keyframe> MakeTrack(const std::vector<std::pair<uint32_t, glm::vec3>>& nodes)
+    {
+        std::vector<Types::Keyframe> keyframes;
+        for (const auto& [tick, rotation] : nodes)
+            keyframes.emplace_back(cameraProperty, tick, Types::CameraData{glm::vec3(0.0f), rotation, 90.0f});
+        return keyframes;
+    }
+
+    // Difference between two angles in degrees, ignoring whole turns
+    float AngleDifference(float a, float b)
+    {
+        return std::abs(std::remainder(a - b, 360.0f));
+    }
+
+    glm::quat GetRotation(const MathUtils::RotationSpline& spline, float tick, bool linear, glm::quat hemisphere)
+    {
+        auto rotation = MathUtils::QuaternionFromAngles(linear ? spline.EvaluateLinear(tick) : spline.Evaluate(tick));
+        return glm::dot(rotation, hemisphere) < 0.0f ? -rotation : rotation;
+    }
+
+    // Whether the rotation and its rate of change are the same on both sides of the tick
+    bool IsSmoothAt(const MathUtils::RotationSpline& spline, float tick, bool linear)
+    {
+        constexpr float STEP = 0.5f;
+
+        const auto center = GetRotation(spline, tick, linear, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        const auto before = GetRotation(spline, tick - STEP, linear, center);
+        const auto after = GetRotation(spline, tick + STEP, linear, center);
+
+        // a kink changes the velocity by about as much as the velocity itself, a smooth curve only by O(STEP)
+        const auto velocityBefore = center - before;
+        const auto velocityAfter = after - center;
+        return glm::length(velocityAfter - velocityBefore) <
+               0.1f * std::max(glm::length(velocityBefore), glm::length(velocityAfter));
+    }
+
+    void TestPassesThroughKeyframes()
+    {
+        const auto keyframes = MakeTrack({
+            {0, {0.0f, 0.0f, 0.0f}},
+            {100, {20.0f, 90.0f, 0.0f}},
+            {250, {-30.0f, 170.0f, 10.0f}},
+            {300, {10.0f, -120.0f, 0.0f}},
+        });
+
+        MathUtils::RotationSpline spline;
+        spline.Build(keyframes);
+
+        for (const auto& keyframe : keyframes)
+        {
+            const auto tick = static_cast<float>(keyframe.tick);
+            const auto angles = spline.Evaluate(tick);
+            const auto& expected = keyframe.value.cameraData.rotation;
+            for (glm::length_t i = 0; i < 3; i++)
+                Check(AngleDifference(angles[i], expected[i]) < 0.01f, "passes through keyframe", tick);
+        }
+    }
+
+    void TestContinuity()
+    {
+        const auto keyframes = MakeTrack({
+            {0, {0.0f, 0.0f, 0.0f}},
+            {100, {20.0f, 90.0f, 0.0f}},
+            {200, {-30.0f, 170.0f, 10.0f}},
+            {300, {10.0f, -120.0f, 0.0f}},
+            {400, {0.0f, -60.0f, -5.0f}},
+        });
+
+        MathUtils::RotationSpline spline;
+        spline.Build(keyframes);
+
+        // the rotation doesn't jump anywhere
+        for (float tick = 1.0f; tick < 400.0f; tick += 1.0f)
+        {
+            const auto previous = MathUtils::QuaternionFromAngles(spline.Evaluate(tick - 1.0f));
+            const auto current = MathUtils::QuaternionFromAngles(spline.Evaluate(tick));
+            Check(std::abs(glm::dot(previous, current)) > std::cos(glm::radians(5.0f) / 2.0f), "continuous rotation",
+                  tick);
+        }
+
+        // squad keeps the angular velocity continuous across segment boundaries, slerp doesn't
+        for (std::size_t i = 1; i + 1 < keyframes.size(); i++)
+        {
+            const auto tick = static_cast<float>(keyframes[i].tick);
+            Check(IsSmoothAt(spline, tick, false), "continuous derivative across the segment boundary", tick);
+            Check(!IsSmoothAt(spline, tick, true), "linear interpolation has a kink at the segment boundary", tick);
+        }
+
+        // and within the segments
+        for (float tick = 10.0f; tick < 400.0f; tick += 100.0f)
+            Check(IsSmoothAt(spline, tick, false), "continuous derivative within the segment", tick);
+    }
+
+    void TestNonUniformSpacing()
+    {
+        // short segments next to long ones, where tangents that assume equal lengths make the speed jump at the keys
+        const auto keyframes = MakeTrack({
+            {0, {0.0f, 0.0f, 0.0f}},
+            {20, {5.0f, 20.0f, 0.0f}},
+            {300, {-20.0f, 140.0f, 10.0f}},
+            {330, {-15.0f, 160.0f, 5.0f}},
+            {600, {10.0f, -100.0f, 0.0f}},
+        });
+
+        MathUtils::RotationSpline spline;
+        spline.Build(keyframes);
+
+        for (std::size_t i = 1; i + 1 < keyframes.size(); i++)
+        {
+            const auto tick = static_cast<float>(keyframes[i].tick);
+            Check(IsSmoothAt(spline, tick, false), "continuous derivative across unevenly spaced keys", tick);
+        }
+
+        for (const auto& keyframe : keyframes)
+        {
+            const auto tick = static_cast<float>(keyframe.tick);
+            const auto angles = spline.Evaluate(tick);
+            for (glm::length_t i = 0; i < 3; i++)
+            {
+                Check(AngleDifference(angles[i], keyframe.value.cameraData.rotation[i]) < 0.01f,
+                      "passes through unevenly spaced keyframe", tick);
+            }
+        }
+    }
+
+    void TestShortestArc()
+    {
+        // 170 -> -170 is 20 degrees through 180, not 340 degrees through 0
+        const auto keyframes = MakeTrack({
+            {0, {0.0f, 170.0f, 0.0f}},
+            {100, {0.0f, -170.0f, 0.0f}},
+            {200, {0.0f, -150.0f, 0.0f}},
+        });
+
+        MathUtils::RotationSpline spline;
+        spline.Build(keyframes);
+
+        Check(AngleDifference(spline.Evaluate(50.0f)[1], 180.0f) < 1.0f, "shortest arc through 180", 50.0f);
+        Check(AngleDifference(spline.EvaluateLinear(50.0f)[1], 180.0f) < 0.01f, "linear shortest arc through 180",
+              50.0f);
+
+        for (float tick = 0.0f; tick <= 100.0f; tick += 5.0f)
+        {
+            Check(AngleDifference(spline.Evaluate(tick)[1], 180.0f) <= 10.5f, "stays between 170 and -170", tick);
+            Check(AngleDifference(spline.EvaluateLinear(tick)[1], 180.0f) <= 10.01f,
+                  "linear stays between 170 and -170", tick);
+        }
+    }
+}  // namespace IWXMVM::Tests
+
+int main()
+{
+    using namespace IWXMVM::Tests;
+
+    TestPassesThroughKeyframes();
+    TestContinuity();
+    TestNonUniformSpacing();
+    TestShortestArc();
+
+    if (failureCount > 0)
+    {
+        std::fprintf(stderr, "%d checks failed\n", failureCount);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "StdInclude.hpp"
+
+#include "Utilities/DemoReads.hpp"
+
+#include <cstdio>
+
+// Replays a demo read trace recorded in the debug panel outside of the game:
+//   iwxmvm-replay-demo-reads <trace> [demo]
+// The demo defaults to the path it was recorded from. Exits with 1 if the trace can't be replayed, and with 2 if any
+// read broke one of the invariants the rewinding code relies on.
+
+int main(int argc, char** argv)
+{
+    using namespace IWXMVM;
+
+    if (argc < 2 || argc > 3)
+    {
+        std::fprintf(stderr, "Usage: %s <trace> [demo]\n", argv[0]);
+        return 1;
+    }
+
+    std::string error;
+    const auto result = DemoReads::Replay(argv[1], argc == 3 ? argv[2] : std::filesystem::path(), error);
+    if (!result.has_value())
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    for (const auto& violation : result->violations)
+        std::fprintf(stderr, "%s\n", violation.c_str());
+
+    std::printf("Replayed %zu demo reads (%zu seeks, %llu bytes) in %.2f ms with %zu invariant violations\n",
+                result->readCount, result->seekCount, static_cast<unsigned long long>(result->byteCount),
+                result->milliseconds, result->violationCount);
+    return result->violationCount > 0 ? 2 : 0;
+}
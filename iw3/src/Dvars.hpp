@@ -0,0 +1,101 @@
+#pragma once
+#include "Structures.hpp"
+#include "Functions.hpp"
+
+namespace IWXMVM::IW3::Dvars
+{
+    // Dvars live in a fixed pool and are never unregistered. Registering one again, e.g. on vid_restart or when a
+    // demo loads the game module, reuses its slot, so a resolved pointer stays valid for the rest of the session.
+    // Dvars that don't exist yet are looked up on every access.
+    // Dereferencing a handle gives the current value as the member of the value union that matches T
+    template <typename T>
+    class Dvar
+    {
+       public:
+        explicit Dvar(const char* name) : name(name)
+        {
+        }
+
+        // nullptr if the dvar isn't registered (yet)
+        Structures::dvar_s* Resolve()
+        {
+            if (dvar == nullptr)
+                dvar = Functions::FindDvar(name);
+            return dvar;
+        }
+
+        Structures::dvar_s* operator->()
+        {
+            const auto resolvedDvar = Resolve();
+            assert(resolvedDvar != nullptr);
+            return resolvedDvar;
+        }
+
+        T& operator*()
+        {
+            auto& value = operator->()->current;
+            if constexpr (std::is_same_v<T, bool>)
+                return value.enabled;
+            else if constexpr (std::is_same_v<T, int32_t>)
+                return value.integer;
+            else if constexpr (std::is_same_v<T, float>)
+                return value.value;
+            else if constexpr (std::is_same_v<T, float[4]>)
+                return value.vector;
+            else if constexpr (std::is_same_v<T, const char*>)
+                return value.string;
+            else
+                static_assert(sizeof(T) == 0, "Unsupported dvar type");
+        }
+
+       private:
+        const char* name;
+        Structures::dvar_s* dvar = nullptr;
+    };
+
+    inline Dvar<bool> cl_ingame{"cl_ingame"};
+    inline Dvar<bool> sv_cheats{"sv_cheats"};
+    inline Dvar<bool> raw_input{"raw_input"};
+    inline Dvar<float> con_gamemsgwindow0msgtime{"con_gamemsgwindow0msgtime"};
+    inline Dvar<int32_t> con_gamemsgwindow0linecount{"con_gamemsgwindow0linecount"};
+
+    inline Dvar<float> cg_fov{"cg_fov"};
+    inline Dvar<bool> cg_thirdperson{"cg_thirdperson"};
+    inline Dvar<float> r_lodBiasRigid{"r_lodBiasRigid"};
+    inline Dvar<float> r_lodBiasSkinned{"r_lodBiasSkinned"};
+
+    inline Dvar<float[4]> r_lightTweakSunDirection{"r_lightTweakSunDirection"};
+    inline Dvar<int32_t> r_lightTweakSunColor{"r_lightTweakSunColor"};
+    inline Dvar<float> r_lightTweakSunLight{"r_lightTweakSunLight"};
+
+    inline Dvar<bool> r_dof_tweak{"r_dof_tweak"};
+    inline Dvar<bool> r_dof_enable{"r_dof_enable"};
+    inline Dvar<float> r_dof_farBlur{"r_dof_farBlur"};
+    inline Dvar<float> r_dof_farStart{"r_dof_farStart"};
+    inline Dvar<float> r_dof_farEnd{"r_dof_farEnd"};
+    inline Dvar<float> r_dof_nearBlur{"r_dof_nearBlur"};
+    inline Dvar<float> r_dof_nearStart{"r_dof_nearStart"};
+    inline Dvar<float> r_dof_nearEnd{"r_dof_nearEnd"};
+    inline Dvar<float> r_dof_bias{"r_dof_bias"};
+
+    inline Dvar<bool> r_filmUseTweaks{"r_filmUseTweaks"};
+    inline Dvar<bool> r_filmTweakEnable{"r_filmTweakEnable"};
+    inline Dvar<float> r_filmTweakBrightness{"r_filmTweakBrightness"};
+    inline Dvar<float> r_filmTweakContrast{"r_filmTweakContrast"};
+    inline Dvar<float> r_filmTweakDesaturation{"r_filmTweakDesaturation"};
+    inline Dvar<float[4]> r_filmTweakLightTint{"r_filmTweakLightTint"};
+    inline Dvar<float[4]> r_filmTweakDarkTint{"r_filmTweakDarkTint"};
+    inline Dvar<bool> r_filmTweakInvert{"r_filmTweakInvert"};
+
+    inline Dvar<const char*> g_TeamColor_Allies{"g_TeamColor_Allies"};
+    inline Dvar<const char*> g_TeamColor_Axis{"g_TeamColor_Axis"};
+    inline Dvar<bool> cg_draw2D{"cg_draw2D"};
+    inline Dvar<bool> cg_drawShellshock{"cg_drawShellshock"};
+    inline Dvar<bool> ui_hud_hardcore{"ui_hud_hardcore"};
+    inline Dvar<bool> ui_drawCrosshair{"ui_drawCrosshair"};
+    inline Dvar<const char*> ui_hud_obituaries{"ui_hud_obituaries"};
+    inline Dvar<float> cg_centertime{"cg_centertime"};
+    inline Dvar<float> cg_overheadranksize{"cg_overheadranksize"};
+    inline Dvar<float> cg_overheadnamessize{"cg_overheadnamessize"};
+    inline Dvar<float> cg_overheadiconsize{"cg_overheadiconsize"};
+}  // namespace IWXMVM::IW3::Dvars
@@ -1,10 +1,12 @@
 #include "StdInclude.hpp"
 #include "Camera.hpp"
 
+#include "Components/Playback.hpp"
 #include "Utilities/HookManager.hpp"
 #include "Utilities/MathUtils.hpp"
 #include "../Structures.hpp"
 #include "../Functions.hpp"
+#include "../Dvars.hpp"
 #include "../Addresses.hpp"
 #include "Mod.hpp"
 
@@ -32,15 +34,26 @@ namespace IWXMVM::IW3::Hooks::Camera
         refdef.tanHalfFovY = refdef.tanHalfFovX * ((float)refdef.height / (float)refdef.width);
     }
 
-    uintptr_t R_SetViewParmsForScene_Trampoline;
-    void __declspec(naked) R_SetViewParmsForScene_Hook()
+    // Hooked at the entry of R_RenderScene, which takes the refdef in esi. While fast seeking nothing of the scene is
+    // shown, so it isn't drawn at all; the seek itself is advanced from SV_Frame and the UI still draws in EndScene.
+    uintptr_t R_RenderScene_Trampoline;
+    void __declspec(naked) R_RenderScene_Hook()
     {
+        static bool skipScene;
+
         __asm pushad
 
-        R_SetViewParmsForScene();
+        skipScene = Components::Playback::IsFastSeeking();
+        if (!skipScene)
+            R_SetViewParmsForScene();
 
-        __asm popad 
-        __asm jmp R_SetViewParmsForScene_Trampoline
+        __asm popad
+        __asm cmp skipScene, 0
+        __asm jne skip
+        __asm jmp R_RenderScene_Trampoline
+
+    skip:
+        __asm ret
     }
 
     void AnglesToAxis(float* angles)
@@ -118,9 +131,9 @@ namespace IWXMVM::IW3::Hooks::Camera
 
     void Install()
     {
-        // rewrite the camera position and fov
-        HookManager::CreateHook(GetGameAddresses().R_SetViewParmsForScene(), (uintptr_t)R_SetViewParmsForScene_Hook,
-                                &R_SetViewParmsForScene_Trampoline);
+        // rewrite the camera position and fov, and skip the scene while fast seeking
+        HookManager::CreateHook(GetGameAddresses().R_RenderScene(), (uintptr_t)R_RenderScene_Hook,
+                                &R_RenderScene_Trampoline);
 
         // rewrite the camera angles
         AnglesToAxis_Address = GetGameAddresses().AnglesToAxis();
@@ -144,13 +157,13 @@ namespace IWXMVM::IW3::Hooks::Camera
         auto& camera = Components::CameraManager::Get().GetActiveCamera();
         auto isFreeCamera = camera->IsModControlledCameraMode();
 
-        Functions::FindDvar("cg_thirdperson")->current.enabled =
+        *Dvars::cg_thirdperson =
             (camera->GetMode() == Components::Camera::Mode::ThirdPerson || isFreeCamera) ? 1 : 0;
-        Functions::FindDvar("cg_draw2d")->current.enabled = (isFreeCamera) ? 0 : 1;
-        Functions::FindDvar("cg_drawShellshock")->current.enabled = (isFreeCamera) ? 0 : 1;
+        *Dvars::cg_draw2D = (isFreeCamera) ? 0 : 1;
+        *Dvars::cg_drawShellshock = (isFreeCamera) ? 0 : 1;
 
         constexpr int32_t LODBIAS = -40000;
-        Functions::FindDvar("r_lodBiasRigid")->current.value = LODBIAS;
-        Functions::FindDvar("r_lodBiasSkinned")->current.value = LODBIAS;
+        *Dvars::r_lodBiasRigid = LODBIAS;
+        *Dvars::r_lodBiasSkinned = LODBIAS;
     }
 }  // namespace IWXMVM::IW3::Hooks::Camera
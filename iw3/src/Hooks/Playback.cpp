@@ -4,6 +4,7 @@
 #include "Components/Playback.hpp"
 #include "Components/Rewinding.hpp"
 #include "Utilities/HookManager.hpp"
+#include "Utilities/Profiler.hpp"
 #include "Events.hpp"
 #include "../Addresses.hpp"
 #include "../Structures.hpp"
@@ -14,6 +15,7 @@ namespace IWXMVM::IW3::Hooks::Playback
 {
     void SV_Frame_Internal(std::int32_t& msec)
     {
+        PROFILE_ZONE("SV_Frame");
         msec = Components::Playback::CalculatePlaybackDelta(msec);
     }
 
@@ -68,6 +70,7 @@ namespace IWXMVM::IW3::Hooks::Playback
             return FS_Read_Trampoline(buffer, len, f);
         }
 
+        PROFILE_ZONE("FS_Read (demo)");
         auto result = Components::Rewinding::FS_Read(buffer, len);
         if (result == -1)
         {
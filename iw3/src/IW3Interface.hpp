@@ -4,6 +4,7 @@
 
 #include "Structures.hpp"
 #include "Functions.hpp"
+#include "Dvars.hpp"
 #include "Hooks.hpp"
 #include "Events.hpp"
 #include "DemoParser.hpp"
@@ -77,10 +78,9 @@ namespace IWXMVM::IW3
         {
             // disable raw_input because it messes with our IN_Frame patch
             // on cod4x
-            auto raw_input = Functions::FindDvar("raw_input");
-            if (raw_input)
+            if (Dvars::raw_input.Resolve() != nullptr)
             {
-                raw_input->current.enabled = false;
+                *Dvars::raw_input = false;
             }
         }
 
@@ -93,12 +93,12 @@ namespace IWXMVM::IW3
             Events::RegisterListener(EventType::OnCameraChanged, Hooks::Camera::OnCameraChanged);
 
             Events::RegisterListener(EventType::PostDemoLoad, [&]() { 
-                Functions::FindDvar("sv_cheats")->current.enabled = true; 
+                *Dvars::sv_cheats = true; 
                 DisableRawInput();
                     
                 // ensure these are set to their defaults, so our killfeed toggle works properly
-                Functions::FindDvar("con_gamemsgwindow0msgtime")->current.value = 5;
-                Functions::FindDvar("con_gamemsgwindow0linecount")->current.integer = 4;
+                *Dvars::con_gamemsgwindow0msgtime = 5;
+                *Dvars::con_gamemsgwindow0linecount = 4;
             });
         }
 
@@ -122,7 +122,7 @@ namespace IWXMVM::IW3
 
         Types::GameState GetGameState() final
         {
-            if (!Functions::FindDvar("cl_ingame")->current.enabled)
+            if (!*Dvars::cl_ingame)
                 return Types::GameState::MainMenu;
 
             if (Structures::GetClientConnection()->demoplaying)
@@ -243,7 +243,7 @@ namespace IWXMVM::IW3
 
         void PlayDemo(std::filesystem::path demoPath) final
         {
-            Events::Invoke(EventType::PreDemoLoad);
+            Events::Invoke<EventType::PreDemoLoad>();
             
             const auto demoDirectory =
                 std::filesystem::path(GetDvar("fs_basepath")->value->string) / "players" / "demos";
@@ -305,14 +305,14 @@ namespace IWXMVM::IW3
 
         void SetFov(float fov) final
         {
-            Functions::FindDvar("cg_fov")->current.value = fov;
+            *Dvars::cg_fov = fov;
         }
 
         Types::Sun GetSun() final
         {
-            const auto& r_lightTweakSunDirection = Functions::FindDvar("r_lightTweakSunDirection");
-            const auto& r_lightTweakSunColor = Functions::FindDvar("r_lightTweakSunColor");
-            const auto& r_lightTweakSunLight = Functions::FindDvar("r_lightTweakSunLight");
+            auto& r_lightTweakSunDirection = Dvars::r_lightTweakSunDirection;
+            auto& r_lightTweakSunColor = Dvars::r_lightTweakSunColor;
+            auto& r_lightTweakSunLight = Dvars::r_lightTweakSunLight;
 
             auto unpackedColor = glm::unpackUint4x8(r_lightTweakSunColor->current.integer);
 
@@ -323,7 +323,7 @@ namespace IWXMVM::IW3
                 r_lightTweakSunDirection->current.vector[1],
                 r_lightTweakSunDirection->current.vector[2]
             );
-            sun.brightness = Functions::FindDvar("r_lightTweakSunLight")->current.value;
+            sun.brightness = *Dvars::r_lightTweakSunLight;
             return sun;
         }
 
@@ -331,15 +331,14 @@ namespace IWXMVM::IW3
         {
             Types::DoF dof = 
             {
-                Functions::FindDvar("r_dof_tweak")->current.enabled &&
-                    Functions::FindDvar("r_dof_enable")->current.enabled,
-                Functions::FindDvar("r_dof_farBlur")->current.value,
-                Functions::FindDvar("r_dof_farStart")->current.value,
-                Functions::FindDvar("r_dof_farEnd")->current.value,
-                Functions::FindDvar("r_dof_nearBlur")->current.value,
-                Functions::FindDvar("r_dof_nearStart")->current.value,
-                Functions::FindDvar("r_dof_nearEnd")->current.value,
-                Functions::FindDvar("r_dof_bias")->current.value
+                *Dvars::r_dof_tweak && *Dvars::r_dof_enable,
+                *Dvars::r_dof_farBlur,
+                *Dvars::r_dof_farStart,
+                *Dvars::r_dof_farEnd,
+                *Dvars::r_dof_nearBlur,
+                *Dvars::r_dof_nearStart,
+                *Dvars::r_dof_nearEnd,
+                *Dvars::r_dof_bias
             };
 
             return dof;
@@ -348,14 +347,13 @@ namespace IWXMVM::IW3
         Types::Filmtweaks GetFilmtweaks()
         {
             Types::Filmtweaks filmtweaks = {
-                Functions::FindDvar("r_filmUseTweaks")->current.enabled &&
-                    Functions::FindDvar("r_filmTweakEnable")->current.enabled,
-                Functions::FindDvar("r_filmTweakBrightness")->current.value,
-                Functions::FindDvar("r_filmTweakContrast")->current.value,
-                Functions::FindDvar("r_filmTweakDesaturation")->current.value,
-                glm::make_vec3(Functions::FindDvar("r_filmTweakLightTint")->current.vector),
-                glm::make_vec3(Functions::FindDvar("r_filmTweakDarkTint")->current.vector),
-                Functions::FindDvar("r_filmTweakInvert")->current.enabled
+                *Dvars::r_filmUseTweaks && *Dvars::r_filmTweakEnable,
+                *Dvars::r_filmTweakBrightness,
+                *Dvars::r_filmTweakContrast,
+                *Dvars::r_filmTweakDesaturation,
+                glm::make_vec3(*Dvars::r_filmTweakLightTint),
+                glm::make_vec3(*Dvars::r_filmTweakDarkTint),
+                *Dvars::r_filmTweakInvert
             };
 
             return filmtweaks;
@@ -364,22 +362,22 @@ namespace IWXMVM::IW3
         Types::HudInfo GetHudInfo()
         {
             glm::vec3 teamColorAllies;
-            auto ss = std::stringstream(Functions::FindDvar("g_TeamColor_Allies")->current.string);
+            auto ss = std::stringstream(*Dvars::g_TeamColor_Allies);
             ss >> teamColorAllies[0] >> teamColorAllies[1] >> teamColorAllies[2];
             
             glm::vec3 teamColorAxis;
-            ss = std::stringstream(Functions::FindDvar("g_TeamColor_Axis")->current.string);
+            ss = std::stringstream(*Dvars::g_TeamColor_Axis);
             ss >> teamColorAxis[0] >> teamColorAxis[1] >> teamColorAxis[2];
 
             Types::HudInfo hudInfo = {
-                Functions::FindDvar("cg_draw2D")->current.enabled,
-                !Functions::FindDvar("ui_hud_hardcore")->current.enabled,
-                Functions::FindDvar("cg_drawShellshock")->current.enabled,
-                Functions::FindDvar("ui_drawCrosshair")->current.enabled, 
+                *Dvars::cg_draw2D,
+                !*Dvars::ui_hud_hardcore,
+                *Dvars::cg_drawShellshock,
+                *Dvars::ui_drawCrosshair, 
                 Hooks::HUD::showScore,
                 Hooks::HUD::showOtherText, 
                 !Patches::GetGamePatches().CG_DrawPlayerLowHealthOverlay.IsApplied(),
-                Functions::FindDvar("ui_hud_obituaries")->current.string[0] == '1',
+                (*Dvars::ui_hud_obituaries)[0] == '1',
                 teamColorAllies,   
                 teamColorAxis
             };
@@ -389,9 +387,9 @@ namespace IWXMVM::IW3
 
         void SetSun(Types::Sun sun) final
         {
-            const auto& r_lightTweakSunDirection = Functions::FindDvar("r_lightTweakSunDirection");
-            const auto& r_lightTweakSunColor = Functions::FindDvar("r_lightTweakSunColor");
-            const auto& r_lightTweakSunLight = Functions::FindDvar("r_lightTweakSunLight");
+            auto& r_lightTweakSunDirection = Dvars::r_lightTweakSunDirection;
+            auto& r_lightTweakSunColor = Dvars::r_lightTweakSunColor;
+            auto& r_lightTweakSunLight = Dvars::r_lightTweakSunLight;
             auto packedColor = glm::packUint4x8(glm::i8vec4(static_cast<uint8_t>(sun.color.x * 255),
                                                            static_cast<uint8_t>(sun.color.y * 255),
                                                            static_cast<uint8_t>(sun.color.z * 255), 1));
@@ -409,12 +407,12 @@ namespace IWXMVM::IW3
 
         void SetDof(Types::DoF dof) final
         {
-            Functions::FindDvar("r_dof_tweak")->current.enabled = dof.enabled;
-            Functions::FindDvar("r_dof_enable")->current.enabled = dof.enabled;
+            *Dvars::r_dof_tweak = dof.enabled;
+            *Dvars::r_dof_enable = dof.enabled;
             
-            Functions::FindDvar("r_dof_farBlur")->current.value = dof.farBlur;
-            Functions::FindDvar("r_dof_farStart")->current.value = dof.farStart;
-            Functions::FindDvar("r_dof_farEnd")->current.value = dof.farEnd;
+            *Dvars::r_dof_farBlur = dof.farBlur;
+            *Dvars::r_dof_farStart = dof.farStart;
+            *Dvars::r_dof_farEnd = dof.farEnd;
             
             // hacky workaround because nearblur works weirdly in this game
             if (dof.nearBlur < 1.3f)
@@ -424,45 +422,45 @@ namespace IWXMVM::IW3
                 dof.nearEnd = 0;
             }
 
-            Functions::FindDvar("r_dof_nearBlur")->current.value = dof.nearBlur;
-            Functions::FindDvar("r_dof_nearStart")->current.value = dof.nearStart;
-            Functions::FindDvar("r_dof_nearEnd")->current.value = dof.nearEnd;
+            *Dvars::r_dof_nearBlur = dof.nearBlur;
+            *Dvars::r_dof_nearStart = dof.nearStart;
+            *Dvars::r_dof_nearEnd = dof.nearEnd;
 
-            Functions::FindDvar("r_dof_bias")->current.value = dof.bias;
+            *Dvars::r_dof_bias = dof.bias;
         }
 
         void SetFilmtweaks(Types::Filmtweaks filmtweaks) final
         {
-            Functions::FindDvar("r_filmUseTweaks")->current.enabled = filmtweaks.enabled;
-            Functions::FindDvar("r_filmTweakEnable")->current.enabled = filmtweaks.enabled;
-            Functions::FindDvar("r_filmTweakBrightness")->current.value = filmtweaks.brightness;
-            Functions::FindDvar("r_filmTweakContrast")->current.value = filmtweaks.contrast;
-            Functions::FindDvar("r_filmTweakDesaturation")->current.value = filmtweaks.desaturation;
+            *Dvars::r_filmUseTweaks = filmtweaks.enabled;
+            *Dvars::r_filmTweakEnable = filmtweaks.enabled;
+            *Dvars::r_filmTweakBrightness = filmtweaks.brightness;
+            *Dvars::r_filmTweakContrast = filmtweaks.contrast;
+            *Dvars::r_filmTweakDesaturation = filmtweaks.desaturation;
             for (int i = 0; i < 3; ++i)
             {
-                Functions::FindDvar("r_filmTweakLightTint")->current.vector[i] =
+                (*Dvars::r_filmTweakLightTint)[i] =
                     glm::value_ptr(filmtweaks.tintLight)[i];
-                Functions::FindDvar("r_filmTweakDarkTint")->current.vector[i] = glm::value_ptr(filmtweaks.tintDark)[i];
+                (*Dvars::r_filmTweakDarkTint)[i] = glm::value_ptr(filmtweaks.tintDark)[i];
             }
-            Functions::FindDvar("r_filmTweakInvert")->current.enabled = filmtweaks.invert;
+            *Dvars::r_filmTweakInvert = filmtweaks.invert;
         }
 
         void SetHudInfo(Types::HudInfo hudInfo) final
         {
-            Functions::FindDvar("con_gamemsgwindow0msgtime")->current.value = 5;
-            Functions::FindDvar("con_gamemsgwindow0linecount")->current.integer = 4;
+            *Dvars::con_gamemsgwindow0msgtime = 5;
+            *Dvars::con_gamemsgwindow0linecount = 4;
 
-            Functions::FindDvar("cg_draw2D")->current.enabled = hudInfo.show2DElements;
+            *Dvars::cg_draw2D = hudInfo.show2DElements;
 
-            Functions::FindDvar("ui_hud_hardcore")->current.enabled = !hudInfo.showPlayerHUD;
-            Functions::FindDvar("cg_centertime")->current.value = hudInfo.showPlayerHUD ? 5.0f : 0.0f;
-            Functions::FindDvar("cg_overheadranksize")->current.value = hudInfo.showPlayerHUD ? 0.5f : 0;
-            Functions::FindDvar("cg_overheadnamessize")->current.value = hudInfo.showPlayerHUD ? 0.5f : 0;
-            Functions::FindDvar("cg_overheadiconsize")->current.value = hudInfo.showPlayerHUD ? 0.7f : 0;
+            *Dvars::ui_hud_hardcore = !hudInfo.showPlayerHUD;
+            *Dvars::cg_centertime = hudInfo.showPlayerHUD ? 5.0f : 0.0f;
+            *Dvars::cg_overheadranksize = hudInfo.showPlayerHUD ? 0.5f : 0;
+            *Dvars::cg_overheadnamessize = hudInfo.showPlayerHUD ? 0.5f : 0;
+            *Dvars::cg_overheadiconsize = hudInfo.showPlayerHUD ? 0.7f : 0;
 
-            Functions::FindDvar("cg_drawShellshock")->current.enabled = hudInfo.showShellshock;
-            Functions::FindDvar("ui_hud_obituaries")->current.string = hudInfo.showKillfeed ? "1" : "0";
-            Functions::FindDvar("ui_drawCrosshair")->current.enabled = hudInfo.showCrosshair;
+            *Dvars::cg_drawShellshock = hudInfo.showShellshock;
+            *Dvars::ui_hud_obituaries = hudInfo.showKillfeed ? "1" : "0";
+            *Dvars::ui_drawCrosshair = hudInfo.showCrosshair;
             Hooks::HUD::showScore = hudInfo.showScore;
             Hooks::HUD::showOtherText = hudInfo.showOtherText;
             if (hudInfo.showBloodOverlay)
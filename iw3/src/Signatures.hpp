@@ -27,7 +27,7 @@ namespace IWXMVM::IW3::Signatures
         Sig("85 C0 74 ?? 8B FE E8 ?? ?? ?? ?? 8B 0D ?? ?? ?? ?? D9 41 ?? D8 4C 24 0C D9 5E 0C 5F 5E C3", GAType::Code,
             -5, Lambda::FollowCodeFlow) > Dvar_FindMalleableVar;
         Sig("83 EC ?? D9 46 ?? D9 1D ?? ?? ?? ?? D9 46 ?? D9 1D", GAType::Code, -6) > FX_SetupCamera;
-        Sig("8B F8 6A 00 57 E8 ?? ?? ?? ?? D9 46 ?? D9 9F", GAType::Code, -7) > R_SetViewParmsForScene;
+        Sig("8B F8 6A 00 57 E8 ?? ?? ?? ?? D9 46 ?? D9 9F", GAType::Code, -7) > R_RenderScene;
         Sig("8B C6 59 C3 56 E8 ?? ?? ?? ?? 83 C4 04 ?? ?? ?? ?? ?? CC", GAType::Code, 13) > SV_Frame;
         Sig("BA ?? ?? ?? ?? E8 ?? ?? ?? ?? 80 3D", GAType::Data, 1, Lambda::DereferenceAddress) > clientConnection;
         Sig("68 ?? ?? ?? ?? E8 ?? ?? ?? ?? 83 C4 0C 68 ?? ?? ?? ?? C1 E6 04", GAType::Data, 1,
@@ -83,6 +83,11 @@ namespace IWXMVM::IW3::Signatures
         Sig("E8 ?? ?? ?? ?? 8B BB ?? ?? ?? ?? 8B F5", GAType::Code, 13,
             Lambda::FollowCodeFlow) > CG_ExecuteNewServerCommands;
 
+        // the members above only queue their signatures, they are all scanned for at once here
+        IW3Addresses()
+        {
+            IWXMVM::Signatures::ResolvePendingSignatures();
+        }
 
 #undef Sig
 #undef Lambda